@@ -0,0 +1,82 @@
+/**
+ * @class BoundedQueue
+ * @brief A blocking first-in first-out queue of fixed capacity, to pass work between the stages of a pipeline.
+ *
+ * Producers block while the queue is full and consumers block while it is empty, so a fast stage waits for
+ * a slow one instead of buffering without limit. Closing the queue wakes everyone: pushes then fail, and pops
+ * drain what is left before failing.
+ */
+
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <cstddef>
+#include <utility>
+#include <condition_variable>
+
+template <typename T>
+class BoundedQueue {
+    private:
+        std::deque<T> items_;
+        size_t capacity_;
+        bool closed_;
+        std::mutex lock_;
+        std::condition_variable notFull_;
+        std::condition_variable notEmpty_;
+
+    public:
+        /**
+         * @brief Constructs an empty, open queue
+         * @param capacity A const reference to the most items the queue holds (at least 1)
+         */
+        explicit BoundedQueue(const size_t& capacity) : items_{}, capacity_{capacity > 0 ? capacity : 1}, closed_{false} {}
+
+        BoundedQueue(const BoundedQueue&) = delete;
+        BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+        /**
+         * @brief Adds an item at the back, waiting while the queue is full
+         * @param item A (non-const) rvalue reference to the item, moved into the queue
+         * @return True if the item was added. False if the queue was closed (`item` is left unchanged).
+         */
+        bool push(T&& item) {
+            std::unique_lock<std::mutex> guard(lock_);
+            notFull_.wait(guard, [this] { return closed_ || items_.size() < capacity_; });
+            if (closed_) { return false; }
+
+            items_.push_back(std::move(item));
+            guard.unlock();
+            notEmpty_.notify_one();
+            return true;
+        }
+
+        /**
+         * @brief Takes the item at the front, waiting while the queue is empty & open
+         * @param item A (non-const) reference the item is moved into
+         * @return True if an item was taken. False once the queue is closed and empty.
+         */
+        bool pop(T& item) {
+            std::unique_lock<std::mutex> guard(lock_);
+            notEmpty_.wait(guard, [this] { return closed_ || !items_.empty(); });
+            if (items_.empty()) { return false; }
+
+            item = std::move(items_.front());
+            items_.pop_front();
+            guard.unlock();
+            notFull_.notify_one();
+            return true;
+        }
+
+        /**
+         * @brief Closes the queue: pushes fail from now on, and pops fail once the items left are taken
+         */
+        void close() {
+            {
+                std::lock_guard<std::mutex> guard(lock_);
+                closed_ = true;
+            }
+            notFull_.notify_all();
+            notEmpty_.notify_all();
+        }
+};
@@ -4,11 +4,15 @@
 
 #include "ChessBoard.hpp"
 #include "Transform.hpp"
+#include "WorkStealingPool.hpp"
+#include <algorithm>
+#include <iterator>
+#include <unordered_map>
 /**
     * Default constructor. 
     * @post The board is setup with the following restrictions:
-    * 1) board is initialized to a 8x8 2D vector of ChessPiece pointers
-    *      - ChessPiece derived classes are dynamically allocated and constructed as follows:
+    * 1) mailbox is initialized to the 8x8 starting position (no ChessPiece is allocated until getCell asks for it)
+    *      - Pieces are encoded as follows:
     *          - Pieces on the BOTTOM half of the board are set to have color "BLACK"
     *          - Pieces on the UPPER half of the board are set to have color "WHITE"
     *          - Their row & col members reflect their position on the board
@@ -35,107 +39,1418 @@
     * 3) p1_color is set to "BLACK", and p2_color is set to "WHITE"
     */
 ChessBoard::ChessBoard() 
-    : playerOneTurn{true}, p1_color{"BLACK"}, p2_color{"WHITE"}, board{std::vector(8, std::vector<ChessPiece*>(8)) } {
-        // Allocate pieces
-
-        auto add_mirrored = [this] (const int& i, const std::string& type) {
-            if (type == "PAWN") {
-                board[1][i] = new Pawn(p1_color, 1, i, true);
-                board[6][i] = new Pawn(p2_color, 6, i);
-            } else if (type == "ROOK") {
-                board[0][i] = new Rook(p1_color, 0, i);
-                board[7][i] = new Rook(p2_color, 7, i);
-            } else if (type == "KNIGHT") {
-                board[0][i] = new Knight(p1_color, 0, i);
-                board[7][i] = new Knight(p2_color, 7, i);            
-            } else if (type == "BISHOP") {
-                board[0][i] = new Bishop(p1_color, 0, i);
-                board[7][i] = new Bishop(p2_color, 7, i);
-            } else if (type == "KING") {
-                board[0][i] = new King(p1_color, 0, i);
-                board[7][i] = new King(p2_color, 7, i);
-            } else if (type == "QUEEN") {
-                board[0][i] = new Queen(p1_color, 0, i);
-                board[7][i] = new Queen(p2_color, 7, i);
+    : playerOneTurn{true}, p1_color{"BLACK"}, p2_color{"WHITE"}, mailbox{Mailbox::standard()}, enPassantSquare{-1}, pieceCache{} {
+    syncFromMailbox();
+}
+
+/**
+ * @brief Constructs a ChessBoard object with a given board configuration and player turn.
+ * 
+ * @param instance A 2D vector representing a board state, where each element is a pointer to a ChessPiece.
+ * @param p1Turn A boolean indicating whether it's player one's turn. True for player one, false for player two.
+ * 
+ * @post Initializes the board layout, sets player one's color to "BLACK" and player two's color to "WHITE".
+ *      The board takes ownership of the pieces in `board`: getCell returns them until the board is destroyed.
+ */
+ChessBoard::ChessBoard(const std::vector<std::vector<ChessPiece*>>& instance, const bool& p1Turn)
+ : playerOneTurn{p1Turn}, p1_color{"BLACK"}, p2_color{"WHITE"}, mailbox{}, enPassantSquare{-1}, pieceCache{} {
+    for (int i = 0; i < BOARD_LENGTH; i++) {
+        for (int j = 0; j < BOARD_LENGTH; j++) {
+            ChessPiece* piece = instance[i][j];
+            if (!piece) { continue; }
+
+            // Keep the given piece, so getCell hands back the pointer the caller passed in
+            mailbox.set(Mailbox::square(i, j), Mailbox::encode(*piece, p2_color));
+            pieceCache[Mailbox::square(i, j)] = piece;
+        }
+    }
+
+    syncFromMailbox();
+}
+
+/**
+ * @brief Copy constructor. Copies the 64-byte mailbox, without copying or allocating any ChessPiece.
+ * @param other A const reference to the ChessBoard to copy
+ */
+ChessBoard::ChessBoard(const ChessBoard& other)
+ : playerOneTurn{other.playerOneTurn}, p1_color{other.p1_color}, p2_color{other.p2_color}, mailbox{other.mailbox}, 
+   pieceMasks{other.pieceMasks}, colorMasks{other.colorMasks}, enPassantSquare{other.enPassantSquare}, hash{other.hash}, 
+   pawnHash{other.pawnHash}, pieceSquareScores{other.pieceSquareScores}, gamePhase{other.gamePhase}, pieceCache{} {}
+
+/**
+ * @brief Copy assignment operator. Copies the 64-byte mailbox and discards the pieces built by getCell.
+ * @param other A const reference to the ChessBoard to copy
+ * @return A reference to this board
+ */
+ChessBoard& ChessBoard::operator=(const ChessBoard& other) {
+    if (this == &other) { return *this; }
+
+    clearPieceCache();
+    playerOneTurn = other.playerOneTurn;
+    p1_color = other.p1_color;
+    p2_color = other.p2_color;
+    mailbox = other.mailbox;
+    pieceMasks = other.pieceMasks;
+    colorMasks = other.colorMasks;
+    enPassantSquare = other.enPassantSquare;
+    hash = other.hash;
+    pawnHash = other.pawnHash;
+    pieceSquareScores = other.pieceSquareScores;
+    gamePhase = other.gamePhase;
+
+    return *this;
+}
+
+/**
+ * @brief Gets the ChessPiece (if any) at (row, col) on the board
+ * 
+ * @param row The row of the cell
+ * @param col The column of the cell
+ * @return ChessPiece* A pointer to the ChessPiece* at the cell specified by (row, col) on the board
+ * @note The piece is built from the mailbox the first time its cell is read, and is owned by the board. 
+ *      Changes made through the pointer are not written back to the board.
+ */
+ChessPiece* ChessBoard::getCell(const int& row, const int& col) const {
+    ChessPiece*& piece = pieceCache[Mailbox::square(row, col)];
+    if (!piece) { piece = Mailbox::decode(mailbox.at(row, col), row, col, p1_color, p2_color); }
+
+    return piece;
+}
+
+/**
+ * @brief Determines whether the piece on a cell can move to another cell, reading the mailbox directly 
+ *      (no ChessPiece is built and no virtual call is made)
+ * 
+ * @param row A const reference to the row of the moving piece
+ * @param col A const reference to the column of the moving piece
+ * @param target_row A const reference to the row of the target position
+ * @param target_col A const reference to the column of the target position
+ * @return True if there is a piece on (row, col) and it can move to the target position (see MoveRules::canMove). False otherwise.
+ */
+bool ChessBoard::canMove(const int& row, const int& col, const int& target_row, const int& target_col) const {
+    if (row < 0 || row >= BOARD_LENGTH || col < 0 || col >= BOARD_LENGTH) { return false; }
+
+    return MoveRules::canMove(moverAt(row, col), target_row, target_col, mailbox);
+}
+
+/**
+ * @brief Finds every cell the piece on a cell can move to, in one call (reading the mailbox directly)
+ * 
+ * @param row A const reference to the row of the moving piece
+ * @param col A const reference to the column of the moving piece
+ * @return A mask with bit (target_row * BOARD_LENGTH + target_col) set exactly when canMove(row, col, target_row, target_col) is true
+ */
+Attacks::Mask ChessBoard::reachableSquares(const int& row, const int& col) const {
+    if (row < 0 || row >= BOARD_LENGTH || col < 0 || col >= BOARD_LENGTH) { return 0; }
+
+    return MoveRules::reachableSquares(moverAt(row, col), mailbox);
+}
+
+/**
+ * @brief Reads the piece on a cell of the mailbox, as the rules see it
+ * @pre (row, col) is on the board
+ * @return The MoveRules::Mover of the piece on (row, col) (of type PieceType::NONE if the cell is empty)
+ */
+MoveRules::Mover ChessBoard::moverAt(const int& row, const int& col) const {
+    Mailbox::Piece piece = mailbox.at(row, col);
+    ChessPiece::Color color = Mailbox::isWhite(piece) ? ChessPiece::WHITE : ChessPiece::BLACK;
+
+    return MoveRules::Mover{static_cast<PieceType>(Mailbox::typeOf(piece)), color, row, col, Mailbox::isMovingUp(piece), Mailbox::hasMoved(piece)};
+}
+
+/**
+ * @brief Gets the flat representation of the board
+ * @return A const reference to the Mailbox holding a piece code per square
+ */
+const Mailbox& ChessBoard::getMailbox() const {
+    return mailbox;
+}
+
+/**
+ * @brief Deletes every ChessPiece built by getCell
+ * @post Every entry of pieceCache is nullptr
+ */
+void ChessBoard::clearPieceCache() {
+    for (ChessPiece*& piece : pieceCache) {
+        if (!piece) { continue; }
+        delete piece;
+        piece = nullptr;
+    }
+}
+
+/**
+ * @brief Rebuilds pieceMasks, colorMasks, the hashes & the evaluation sums from the mailbox
+ */
+void ChessBoard::syncFromMailbox() {
+    pieceMasks.fill(0);
+    colorMasks.fill(0);
+    hash = 0;
+    pawnHash = 0;
+    pieceSquareScores.fill(PieceSquare::Score{0, 0});
+    gamePhase = 0;
+
+    for (Attacks::Mask occupied = mailbox.occupancy(); occupied; occupied &= occupied - 1) {
+        const int square = __builtin_ctzll(occupied);
+        const Mailbox::Piece piece = mailbox[square];
+
+        int color = Mailbox::isWhite(piece) ? ChessPiece::WHITE : ChessPiece::BLACK;
+        pieceMasks[Mailbox::typeOf(piece)] |= Attacks::squareMask(square);
+        colorMasks[color] |= Attacks::squareMask(square);
+        hash ^= Zobrist::piece(color, Mailbox::typeOf(piece), square);
+        if (Mailbox::typeOf(piece) == Mailbox::PAWN) { pawnHash ^= Zobrist::piece(color, Mailbox::PAWN, square); }
+        pieceSquareScores[color] += PieceSquare::score(color, Mailbox::typeOf(piece), square);
+        gamePhase += PieceSquare::phaseOf(Mailbox::typeOf(piece));
+    }
+
+    hash ^= Zobrist::castling(castlingRights());
+    if (enPassantSquare != -1) { hash ^= Zobrist::enPassant(enPassantSquare % BOARD_LENGTH); }
+    if (sideToMove() == ChessPiece::WHITE) { hash ^= Zobrist::side(); }
+}
+
+/**
+ * @brief Places a piece on an empty square, updating the mailbox, the masks, the hashes and the evaluation sums
+ * @param square A const reference to an empty square
+ * @param piece A const reference to the Piece code to place (not EMPTY)
+ */
+void ChessBoard::putPiece(const int& square, const Mailbox::Piece& piece) {
+    int color = Mailbox::isWhite(piece) ? ChessPiece::WHITE : ChessPiece::BLACK;
+    int type = Mailbox::typeOf(piece);
+
+    mailbox.set(square, piece);
+    pieceMasks[type] |= Attacks::squareMask(square);
+    colorMasks[color] |= Attacks::squareMask(square);
+    hash ^= Zobrist::piece(color, type, square);
+    if (type == Mailbox::PAWN) { pawnHash ^= Zobrist::piece(color, type, square); }
+    pieceSquareScores[color] += PieceSquare::score(color, type, square);
+    gamePhase += PieceSquare::phaseOf(type);
+    dropCachedPiece(square);
+}
+
+/**
+ * @brief Removes the piece on a square, updating the mailbox, the masks, the hashes and the evaluation sums
+ * @param square A const reference to an occupied square
+ */
+void ChessBoard::removePiece(const int& square) {
+    Mailbox::Piece piece = mailbox[square];
+    int color = Mailbox::isWhite(piece) ? ChessPiece::WHITE : ChessPiece::BLACK;
+    int type = Mailbox::typeOf(piece);
+
+    mailbox.set(square, Mailbox::EMPTY);
+    pieceMasks[type] &= ~Attacks::squareMask(square);
+    colorMasks[color] &= ~Attacks::squareMask(square);
+    hash ^= Zobrist::piece(color, type, square);
+    if (type == Mailbox::PAWN) { pawnHash ^= Zobrist::piece(color, type, square); }
+    pieceSquareScores[color] -= PieceSquare::score(color, type, square);
+    gamePhase -= PieceSquare::phaseOf(type);
+    dropCachedPiece(square);
+}
+
+/**
+ * @brief Deletes the ChessPiece built by getCell for a square, since its piece changed
+ * @param square A const reference to a square
+ */
+void ChessBoard::dropCachedPiece(const int& square) {
+    if (pieceCache[square]) {
+        delete pieceCache[square];
+        pieceCache[square] = nullptr;
+    }
+}
+
+/**
+ * @brief Plays a move on the board, in place.
+ * 
+ * The moved piece is flagged as moved. A promoted pawn becomes the piece named by the move, and castling 
+ * spends one of the Rook's castle moves. The hash is updated with a few XORs, without reading the rest of the board.
+ * @pre `move` was generated for this position (see generateLegalMoves / generatePseudoLegalMoves)
+ * @post The other player is to move. getCell builds new pieces for the squares the move changed.
+ * 
+ * @param move A const reference to the Move to play
+ * @return The UndoRecord that takes the board back to this position (see unmakeMove)
+ */
+ChessBoard::UndoRecord ChessBoard::makeMove(const Move& move) {
+    const int from = move.from();
+    const int to = move.to();
+    const ChessPiece::Color us = sideToMove();
+    const int forward = us == ChessPiece::BLACK ? BOARD_LENGTH : -BOARD_LENGTH;
+    const int captureSquare = move.isEnPassant() ? to - forward : to;
+
+    const Mailbox::Piece piece = mailbox[from];
+    UndoRecord undo{move, piece, mailbox[captureSquare], Mailbox::EMPTY, static_cast<int8_t>(enPassantSquare), hash};
+
+    // Only kings & rooks, moving or captured, change the castling rights
+    const bool touchesCastling = Mailbox::typeOf(piece) == Mailbox::KING || Mailbox::typeOf(piece) == Mailbox::ROOK || Mailbox::typeOf(undo.captured) == Mailbox::ROOK;
+    const uint8_t rightsBefore = touchesCastling ? castlingRights() : 0;
+
+    if (enPassantSquare != -1) {
+        hash ^= Zobrist::enPassant(enPassantSquare % BOARD_LENGTH);
+        enPassantSquare = -1;
+    }
+
+    if (undo.captured != Mailbox::EMPTY) { removePiece(captureSquare); }
+    removePiece(from);
+
+    if (move.isPromotion()) {
+        putPiece(to, Mailbox::makePiece(static_cast<Mailbox::Type>(move.promotionType()), Mailbox::isWhite(piece), Mailbox::isMovingUp(piece), Mailbox::MAX_CASTLE_MOVES, true));
+    } else {
+        putPiece(to, piece | Mailbox::MOVED);
+    }
+
+    if (move.isCastle()) {
+        // The rook jumps from its corner over the king, to the cell the king passed through
+        int rookFrom = Mailbox::square(from / BOARD_LENGTH, move.flags() == Move::KING_CASTLE ? 0 : BOARD_LENGTH - 1);
+        undo.rook = mailbox[rookFrom];
+
+        removePiece(rookFrom);
+        putPiece((from + to) / 2, Mailbox::makePiece(Mailbox::ROOK, Mailbox::isWhite(undo.rook), Mailbox::isMovingUp(undo.rook), Mailbox::castleMovesOf(undo.rook) - 1, true));
+    }
+
+    if (move.isDoublePush()) {
+        // Only kept when an enemy pawn can capture onto it, so that equal positions have equal hashes
+        int skipped = from + forward;
+        if (Attacks::pawnAttacks(skipped, us == ChessPiece::BLACK) & pieceMasks[Mailbox::PAWN] & colorMasks[us ^ 1]) {
+            enPassantSquare = skipped;
+            hash ^= Zobrist::enPassant(skipped % BOARD_LENGTH);
+        }
+    }
+
+    if (touchesCastling) { hash ^= Zobrist::castling(rightsBefore) ^ Zobrist::castling(castlingRights()); }
+
+    playerOneTurn = !playerOneTurn;
+    hash ^= Zobrist::side();
+
+    return undo;
+}
+
+/**
+ * @brief Takes back the last move played, restoring the board exactly as it was before it
+ * @pre `undo` was returned by the last makeMove not yet taken back
+ * 
+ * @param undo A const reference to the UndoRecord of the move to take back
+ */
+void ChessBoard::unmakeMove(const UndoRecord& undo) {
+    const Move& move = undo.move;
+    const int from = move.from();
+    const int to = move.to();
+
+    playerOneTurn = !playerOneTurn;
+    const int forward = sideToMove() == ChessPiece::BLACK ? BOARD_LENGTH : -BOARD_LENGTH;
+
+    if (move.isCastle()) {
+        removePiece((from + to) / 2);
+        putPiece(Mailbox::square(from / BOARD_LENGTH, move.flags() == Move::KING_CASTLE ? 0 : BOARD_LENGTH - 1), undo.rook);
+    }
+
+    removePiece(to);
+    putPiece(from, undo.moved);
+    if (undo.captured != Mailbox::EMPTY) { putPiece(move.isEnPassant() ? to - forward : to, undo.captured); }
+
+    // The pieces were put back with their own keys, but the hash also covered the side, castling & en passant terms
+    enPassantSquare = undo.enPassantSquare;
+    hash = undo.hash;
+}
+
+/**
+ * @brief Gets the Zobrist hash of the position: the pieces, the player to move, the castling rights and the en passant column
+ * @return The 64-bit hash. Two boards holding the same position have the same hash.
+ */
+Zobrist::Key ChessBoard::getHash() const {
+    return hash;
+}
+
+/**
+ * @brief Gets the Zobrist hash of the pawns alone: the same keys as getHash, for pawns only
+ * @return The 64-bit hash. Two boards with the same pawns on the same squares have the same pawn hash.
+ */
+Zobrist::Key ChessBoard::getPawnHash() const {
+    return pawnHash;
+}
+
+/**
+ * @brief Gets the material & piece-square score of a player's pieces, kept up to date by makeMove & unmakeMove
+ * @param color A const reference to the color of the player: ChessPiece::BLACK or ChessPiece::WHITE
+ * @return The sum of PieceSquare::score over the player's pieces
+ */
+PieceSquare::Score ChessBoard::getPieceSquareScore(const int& color) const {
+    return pieceSquareScores[color];
+}
+
+/**
+ * @brief Gets the game phase: the sum of PieceSquare::phaseOf over every piece on the board
+ * @return PieceSquare::MAX_PHASE with all the minor & major pieces of the opening, less as they are traded (more after promotions)
+ */
+int ChessBoard::getGamePhase() const {
+    return gamePhase;
+}
+
+/**
+ * @brief Replaces the position with one given without its history, as FEN & PackedPosition give it.
+ * 
+ * Only the type & color of each piece are read from `placed`: the other flags are rebuilt. Pawns off their 
+ * starting row are flagged as moved, and kings & rooks are flagged as moved unless a castling right needs them. 
+ * A castling right whose king or rook is missing is dropped. The en passant square is only kept if a pawn can 
+ * capture onto it (as after makeMove).
+ * 
+ * @param placed A const reference to the pieces to place
+ * @param blackToMove A const reference to a boolean, true if BLACK is to move
+ * @param rights A const reference to the castling rights claimed, as a castlingRights mask
+ * @param skipped A const reference to the en passant square claimed, -1 if there is none
+ * @return True if the position was set. False if it does not have one king per color, has a pawn on a back row,
+ *      or `skipped` was not skipped by a double push of the player who just moved. The board is left unchanged.
+ * @post getCell builds new pieces for every square
+ */
+bool ChessBoard::setPosition(const Mailbox& placed, const bool& blackToMove, const uint8_t& rights, const int& skipped) {
+    Mailbox rebuilt;
+    int kings[2] = {0, 0};
+
+    for (Attacks::Mask occupied = placed.occupancy(); occupied; occupied &= occupied - 1) {
+        const int square = __builtin_ctzll(occupied);
+        const Mailbox::Piece piece = placed[square];
+
+        const Mailbox::Type type = Mailbox::typeOf(piece);
+        const bool white = Mailbox::isWhite(piece);
+        const int row = square / BOARD_LENGTH;
+
+        bool moved = type == Mailbox::KING || type == Mailbox::ROOK;    // Until a castling right says otherwise
+        if (type == Mailbox::PAWN) {
+            if (row == 0 || row == BOARD_LENGTH - 1) { return false; }
+            moved = row != (white ? BOARD_LENGTH - 2 : 1);
+        }
+        if (type == Mailbox::KING) { kings[white]++; }
+
+        rebuilt.set(square, Mailbox::makePiece(type, white, type == Mailbox::PAWN && !white, Mailbox::MAX_CASTLE_MOVES, moved));
+    }
+    if (kings[0] != 1 || kings[1] != 1) { return false; }
+
+    // Each castling right frees its king & rook, if both are home
+    for (const uint8_t& right : {BLACK_KING_CASTLE, BLACK_QUEEN_CASTLE, WHITE_KING_CASTLE, WHITE_QUEEN_CASTLE}) {
+        if (!(rights & right)) { continue; }
+
+        const bool white = right == WHITE_KING_CASTLE || right == WHITE_QUEEN_CASTLE;
+        const int home = white ? BOARD_LENGTH - 1 : 0;
+        const int rookCol = right == BLACK_KING_CASTLE || right == WHITE_KING_CASTLE ? 0 : BOARD_LENGTH - 1;
+        const Mailbox::Piece king = rebuilt.at(home, KING_COLUMN);
+        const Mailbox::Piece rook = rebuilt.at(home, rookCol);
+        if (Mailbox::typeOf(king) != Mailbox::KING || Mailbox::isWhite(king) != white || 
+            Mailbox::typeOf(rook) != Mailbox::ROOK || Mailbox::isWhite(rook) != white) { continue; }
+
+        rebuilt.set(Mailbox::square(home, KING_COLUMN), king & ~Mailbox::MOVED);
+        rebuilt.set(Mailbox::square(home, rookCol), rook & ~Mailbox::MOVED);
+    }
+
+    // BLACK pawns double push from row 1 over row 2, WHITE pawns from row 6 over row 5
+    if (skipped != -1) {
+        const int forward = blackToMove ? -BOARD_LENGTH : BOARD_LENGTH;
+        const Mailbox::Piece pushed = skipped + forward >= 0 && skipped + forward < Mailbox::SQUARES ? rebuilt[skipped + forward] : Mailbox::EMPTY;
+        if (skipped / BOARD_LENGTH != (blackToMove ? BOARD_LENGTH - 3 : 2) || rebuilt[skipped] != Mailbox::EMPTY ||
+            Mailbox::typeOf(pushed) != Mailbox::PAWN || Mailbox::isWhite(pushed) != blackToMove) { return false; }
+    }
+
+    clearPieceCache();
+    mailbox = rebuilt;
+    playerOneTurn = blackToMove;
+    enPassantSquare = -1;
+    syncFromMailbox();
+
+    // Only kept when a pawn can capture onto it, so that equal positions have equal hashes
+    const int mover = sideToMove() ^ 1;
+    if (skipped != -1 && (Attacks::pawnAttacks(skipped, mover == ChessPiece::BLACK) & pieceMasks[Mailbox::PAWN] & colorMasks[mover ^ 1])) {
+        enPassantSquare = skipped;
+        hash ^= Zobrist::enPassant(skipped % BOARD_LENGTH);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Replaces the position with one read from Forsyth-Edwards Notation, without allocating.
+ * 
+ * The standard board maps onto this one rotated: rank r is row 8 - r and file f is column 'h' - f, so WHITE
+ * holds rows 6 & 7 and BLACK's pawns move up. Pawns off their starting row are flagged as moved, and kings 
+ * & rooks are flagged as moved unless a castling right needs them. A castling right whose king or rook is 
+ * missing is dropped. The en passant square is only kept if a pawn can capture onto it (as after makeMove).
+ * The halfmove clock & fullmove number are optional and ignored: the board keeps no move counters.
+ * 
+ * @param fen A const reference to the FEN, such as "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"
+ * @return True if the position was read. False if `fen` is malformed, does not have one king per color and 
+ *      no pawn on a back rank, or names an en passant square no double push of the player who just moved could 
+ *      have skipped (it must be empty, on the skipped rank, in front of that player's pawn). The board is left unchanged.
+ * @post getCell builds new pieces for every square
+ */
+bool ChessBoard::setFromFen(const std::string_view& fen) {
+    size_t i = 0;
+    auto skipSpaces = [&fen, &i] () { 
+        size_t start = i;
+        while (i < fen.size() && fen[i] == ' ') { i++; } 
+        return i > start;
+    };
+
+    // Piece placement, from rank 8 down to rank 1
+    Mailbox placed;
+    int row = 0, col = BOARD_LENGTH - 1;
+    for (; i < fen.size() && fen[i] != ' '; i++) {
+        const char c = fen[i];
+        if (c == '/') {
+            if (col != -1 || ++row >= BOARD_LENGTH) { return false; }
+            col = BOARD_LENGTH - 1;
+            continue;
+        }
+        if (c >= '1' && c <= '8') {
+            col -= c - '0';
+            if (col < -1) { return false; }
+            continue;
+        }
+
+        Mailbox::Type type;
+        switch (c | 0x20) {
+            case 'p': type = Mailbox::PAWN; break;
+            case 'n': type = Mailbox::KNIGHT; break;
+            case 'b': type = Mailbox::BISHOP; break;
+            case 'r': type = Mailbox::ROOK; break;
+            case 'q': type = Mailbox::QUEEN; break;
+            case 'k': type = Mailbox::KING; break;
+            default: return false;
+        }
+        if (col < 0) { return false; }
+
+        placed.set(Mailbox::square(row, col--), Mailbox::makePiece(type, c < 'a'));
+    }
+    if (row != BOARD_LENGTH - 1 || col != -1) { return false; }
+
+    // Side to move
+    if (!skipSpaces() || i >= fen.size() || (fen[i] != 'w' && fen[i] != 'b')) { return false; }
+    const bool blackToMove = fen[i++] == 'b';
+
+    // Castling rights
+    if (!skipSpaces() || i >= fen.size()) { return false; }
+    uint8_t rights = 0;
+    if (fen[i] == '-') { 
+        i++; 
+    } else {
+        for (; i < fen.size() && fen[i] != ' '; i++) {
+            switch (fen[i]) {
+                case 'K': rights |= WHITE_KING_CASTLE; break;
+                case 'Q': rights |= WHITE_QUEEN_CASTLE; break;
+                case 'k': rights |= BLACK_KING_CASTLE; break;
+                case 'q': rights |= BLACK_QUEEN_CASTLE; break;
+                default: return false;
+            }
+        }
+    }
+
+    // En passant: the square skipped by the double push the opponent just played
+    if (!skipSpaces() || i >= fen.size()) { return false; }
+    int skipped = -1;
+    if (fen[i] == '-') {
+        i++;
+    } else {
+        if (i + 1 >= fen.size() || fen[i] < 'a' || fen[i] > 'h' || fen[i + 1] < '1' || fen[i + 1] > '8') { return false; }
+        skipped = Mailbox::square('8' - fen[i + 1], 'h' - fen[i]);
+        i += 2;
+    }
+
+    // The halfmove clock & fullmove number, when present, must be numbers
+    for (int counter = 0; counter < 2 && skipSpaces() && i < fen.size(); counter++) {
+        if (fen[i] < '0' || fen[i] > '9') { return false; }
+        while (i < fen.size() && fen[i] >= '0' && fen[i] <= '9') { i++; }
+    }
+    skipSpaces();
+    if (i != fen.size()) { return false; }
+
+    return setPosition(placed, blackToMove, rights, skipped);
+}
+
+/**
+ * @brief Replaces the position with a packed one, without allocating
+ * 
+ * The flags the packed format does not hold are rebuilt as setFromFen rebuilds them.
+ * 
+ * @param packed A const reference to the PackedPosition
+ * @return True if the position was read. False if it holds an invalid piece code or en passant square, or does not
+ *      have one king per color and no pawn on a back rank. The board is left unchanged.
+ * @post getCell builds new pieces for every square
+ */
+bool ChessBoard::setFromPacked(const PackedPosition& packed) {
+    Mailbox placed;
+
+    int index = 0;
+    for (uint64_t occupied = packed.occupancy; occupied; occupied &= occupied - 1, index++) {
+        const Mailbox::Piece code = (packed.pieces[index / 2] >> (4 * (index % 2))) & 0x0F;
+        if (Mailbox::typeOf(code) == Mailbox::NONE || Mailbox::typeOf(code) > Mailbox::KING) { return false; }
+
+        placed.set(__builtin_ctzll(occupied), code);
+    }
+
+    const int skipped = packed.enPassantSquare();
+    if (skipped >= Mailbox::SQUARES) { return false; }
+
+    return setPosition(placed, packed.sideToMove() == ChessPiece::BLACK, packed.castlingRights(), skipped);
+}
+
+/**
+ * @brief Packs the position into 32 bytes
+ * @param packed A (non-const) reference to the PackedPosition to write. Its reserved bytes are zeroed.
+ * @return True if the position was packed. False if it holds more than PackedPosition::MAX_PIECES pieces (`packed` is left unchanged).
+ */
+bool ChessBoard::writePacked(PackedPosition& packed) const {
+    const Attacks::Mask occupied = colorMasks[ChessPiece::BLACK] | colorMasks[ChessPiece::WHITE];
+    if (__builtin_popcountll(occupied) > PackedPosition::MAX_PIECES) { return false; }
+
+    packed = PackedPosition{};
+    packed.occupancy = occupied;
+
+    int index = 0;
+    for (Attacks::Mask squares = occupied; squares; squares &= squares - 1, index++) {
+        const Mailbox::Piece code = mailbox[__builtin_ctzll(squares)] & (Mailbox::TYPE_MASK | Mailbox::WHITE);
+        packed.pieces[index / 2] |= code << (4 * (index % 2));
+    }
+
+    packed.state = (sideToMove() == ChessPiece::WHITE ? PackedPosition::WHITE_TO_MOVE : 0) | (castlingRights() << PackedPosition::CASTLING_SHIFT);
+    packed.enPassant = enPassantSquare == -1 ? PackedPosition::NO_EN_PASSANT : static_cast<uint8_t>(enPassantSquare);
+
+    return true;
+}
+
+/**
+ * @brief Finds the legal move written in Standard Algebraic Notation, such as "Nbd7", "exd5", "e8=Q+" or "O-O-O"
+ * 
+ * Squares are read as in setFromFen. Check & annotation suffixes ("+", "#", "!", "?") are ignored, castling may be 
+ * written with zeros, and the "=" of a promotion may be left out.
+ * 
+ * @param san A const reference to the move
+ * @return The legal Move it names. Move::none() if it is malformed, names no legal move, or is ambiguous.
+ */
+Move ChessBoard::moveFromSan(const std::string_view& san) const {
+    size_t end = san.size();
+    while (end > 0 && (san[end - 1] == '+' || san[end - 1] == '#' || san[end - 1] == '!' || san[end - 1] == '?')) { end--; }
+    std::string_view text = san.substr(0, end);
+    if (text.size() < 2) { return Move::none(); }
+
+    auto typeOfLetter = [] (const char& letter) {
+        switch (letter) {
+            case 'N': return Mailbox::KNIGHT;
+            case 'B': return Mailbox::BISHOP;
+            case 'R': return Mailbox::ROOK;
+            case 'Q': return Mailbox::QUEEN;
+            case 'K': return Mailbox::KING;
+            default: return Mailbox::NONE;
+        }
+    };
+
+    MoveList moves;
+    generateLegalMoves(moves);
+
+    // Castling names no square
+    if (text == "O-O" || text == "0-0" || text == "O-O-O" || text == "0-0-0") {
+        const int flag = text.size() == 3 ? Move::KING_CASTLE : Move::QUEEN_CASTLE;
+        for (const Move& move : moves) {
+            if (move.flags() == flag) { return move; }
+        }
+        return Move::none();
+    }
+
+    // The moving piece: a letter, or none for a pawn
+    Mailbox::Type type = typeOfLetter(text[0]);
+    if (type != Mailbox::NONE) { 
+        text.remove_prefix(1); 
+    } else {
+        type = Mailbox::PAWN;
+    }
+
+    // The promotion, at the end: "=Q" or "Q"
+    Mailbox::Type promotion = Mailbox::NONE;
+    if (!text.empty() && typeOfLetter(text.back()) != Mailbox::NONE) {
+        promotion = typeOfLetter(text.back());
+        text.remove_suffix(1);
+        if (!text.empty() && text.back() == '=') { text.remove_suffix(1); }
+        if (type != Mailbox::PAWN || promotion == Mailbox::KING) { return Move::none(); }
+    }
+
+    // The destination, then what is left before it: an optional file and/or rank of the origin, and an optional "x"
+    if (text.size() < 2) { return Move::none(); }
+    const char file = text[text.size() - 2], rank = text[text.size() - 1];
+    if (file < 'a' || file > 'h' || rank < '1' || rank > '8') { return Move::none(); }
+    const int to = Mailbox::square('8' - rank, 'h' - file);
+    text.remove_suffix(2);
+
+    if (!text.empty() && text.back() == 'x') { text.remove_suffix(1); }
+    int fromRow = -1, fromCol = -1;
+    for (const char& c : text) {
+        if (c >= 'a' && c <= 'h' && fromCol == -1 && fromRow == -1) { fromCol = 'h' - c; }
+        else if (c >= '1' && c <= '8' && fromRow == -1) { fromRow = '8' - c; }
+        else { return Move::none(); }
+    }
+
+    Move found = Move::none();
+    for (const Move& move : moves) {
+        if (move.to() != to || move.isCastle() || Mailbox::typeOf(mailbox[move.from()]) != type) { continue; }
+        if ((fromRow != -1 && move.from() / BOARD_LENGTH != fromRow) || (fromCol != -1 && move.from() % BOARD_LENGTH != fromCol)) { continue; }
+        if (move.isPromotion() != (promotion != Mailbox::NONE) || (move.isPromotion() && static_cast<int>(move.promotionType()) != promotion)) { continue; }
+
+        if (found != Move::none()) { return Move::none(); }
+        found = move;
+    }
+
+    return found;
+}
+
+/**
+ * @brief Writes the position in Forsyth-Edwards Notation, without allocating
+ * @param buffer A pointer to the first character to write
+ * @param capacity A const reference to the number of characters `buffer` holds. FEN_BUFFER_SIZE is always enough.
+ * @return The length of the FEN, not counting the '\0' written after it. 0 if it does not fit (nothing is written).
+ * @note The halfmove clock & fullmove number are written as "0 1"
+ */
+size_t ChessBoard::writeFen(char* buffer, const size_t& capacity) const {
+    static constexpr char LETTERS[] = " pnbrqk";
+
+    char fen[FEN_BUFFER_SIZE];
+    size_t length = 0;
+
+    for (int row = 0; row < BOARD_LENGTH; row++) {
+        int empty = 0;
+        for (int col = BOARD_LENGTH - 1; col >= 0; col--) {
+            const Mailbox::Piece piece = mailbox.at(row, col);
+            if (piece == Mailbox::EMPTY) { 
+                empty++; 
+                continue; 
+            }
+
+            if (empty) { fen[length++] = static_cast<char>('0' + empty); }
+            empty = 0;
+            fen[length++] = static_cast<char>(LETTERS[Mailbox::typeOf(piece)] - (Mailbox::isWhite(piece) ? 0x20 : 0));
+        }
+
+        if (empty) { fen[length++] = static_cast<char>('0' + empty); }
+        if (row != BOARD_LENGTH - 1) { fen[length++] = '/'; }
+    }
+
+    fen[length++] = ' ';
+    fen[length++] = sideToMove() == ChessPiece::WHITE ? 'w' : 'b';
+    fen[length++] = ' ';
+
+    const uint8_t rights = castlingRights();
+    if (rights & WHITE_KING_CASTLE) { fen[length++] = 'K'; }
+    if (rights & WHITE_QUEEN_CASTLE) { fen[length++] = 'Q'; }
+    if (rights & BLACK_KING_CASTLE) { fen[length++] = 'k'; }
+    if (rights & BLACK_QUEEN_CASTLE) { fen[length++] = 'q'; }
+    if (!rights) { fen[length++] = '-'; }
+    fen[length++] = ' ';
+
+    if (enPassantSquare == -1) {
+        fen[length++] = '-';
+    } else {
+        fen[length++] = static_cast<char>('h' - enPassantSquare % BOARD_LENGTH);
+        fen[length++] = static_cast<char>('8' - enPassantSquare / BOARD_LENGTH);
+    }
+
+    for (const char& c : {' ', '0', ' ', '1'}) { fen[length++] = c; }
+
+    if (length + 1 > capacity) { return 0; }
+    std::copy(fen, fen + length, buffer);
+    buffer[length] = '\0';
+
+    return length;
+}
+
+/**
+ * @brief Gets the position in Forsyth-Edwards Notation (see writeFen)
+ * @return The FEN of the position
+ */
+std::string ChessBoard::toFen() const {
+    char fen[FEN_BUFFER_SIZE];
+    return std::string(fen, writeFen(fen, FEN_BUFFER_SIZE));
+}
+
+/**
+ * @brief Gets the color of the player to move
+ * @return ChessPiece::BLACK (player one) if playerOneTurn is true. ChessPiece::WHITE otherwise.
+ */
+ChessPiece::Color ChessBoard::sideToMove() const {
+    return playerOneTurn ? ChessPiece::BLACK : ChessPiece::WHITE;
+}
+
+/**
+ * @brief Gets the square a pawn can capture en passant onto
+ * @return The square skipped by the last double push, -1 if the last move was not a double push
+ */
+int ChessBoard::getEnPassantSquare() const {
+    return enPassantSquare;
+}
+
+/**
+ * @brief Gets the castling rights of both players.
+ * 
+ * A side may castle towards a corner while its king is unmoved on column 3 of its back row, and the Rook in 
+ * that corner is unmoved with castle moves left (see Rook::canCastle). King side castling is towards column 0.
+ * 
+ * @return A mask of BLACK_KING_CASTLE, BLACK_QUEEN_CASTLE, WHITE_KING_CASTLE and WHITE_QUEEN_CASTLE
+ */
+uint8_t ChessBoard::castlingRights() const {
+    uint8_t rights = 0;
+
+    for (const bool& white : {false, true}) {
+        int row = white ? BOARD_LENGTH - 1 : 0;
+
+        Mailbox::Piece king = mailbox.at(row, KING_COLUMN);
+        if (Mailbox::typeOf(king) != Mailbox::KING || Mailbox::isWhite(king) != white || Mailbox::hasMoved(king)) { continue; }
+
+        for (const int& col : {0, BOARD_LENGTH - 1}) {
+            Mailbox::Piece rook = mailbox.at(row, col);
+            if (Mailbox::typeOf(rook) != Mailbox::ROOK || Mailbox::isWhite(rook) != white || Mailbox::hasMoved(rook) || Mailbox::castleMovesOf(rook) == 0) { continue; }
+
+            uint8_t right = col == 0 ? BLACK_KING_CASTLE : BLACK_QUEEN_CASTLE;
+            rights |= white ? right << 2 : right;
+        }
+    }
+
+    return rights;
+}
+
+/**
+ * @brief Gets the squares held by the pieces of one color & type
+ * @param color A const reference to ChessPiece::BLACK or ChessPiece::WHITE
+ * @param type A const reference to a PieceType (NONE gives an empty mask)
+ * @return A mask with bit (row * BOARD_LENGTH + col) set for every piece of `color` and `type`
+ */
+Attacks::Mask ChessBoard::getPieces(const ChessPiece::Color& color, const PieceType& type) const {
+    return type == PieceType::NONE ? 0 : pieceMasks[static_cast<int>(type)] & colorMasks[color];
+}
+
+/**
+ * @brief Finds every piece, of either color, attacking a square
+ * @param square A const reference to a square (row * BOARD_LENGTH + col)
+ * @param occupied A const reference to the mask of occupied squares that block rooks, bishops & queens
+ * @return The mask of the squares holding a piece that attacks `square`
+ */
+Attacks::Mask ChessBoard::attackersTo(const int& square, const Attacks::Mask& occupied) const {
+    Attacks::Mask diagonals = pieceMasks[Mailbox::BISHOP] | pieceMasks[Mailbox::QUEEN];
+    Attacks::Mask lines = pieceMasks[Mailbox::ROOK] | pieceMasks[Mailbox::QUEEN];
+
+    // A pawn attacks a square from the row behind it, so the attackers are found by looking the other way
+    return (Attacks::pawnAttacks(square, true) & pieceMasks[Mailbox::PAWN] & colorMasks[ChessPiece::WHITE]) |
+        (Attacks::pawnAttacks(square, false) & pieceMasks[Mailbox::PAWN] & colorMasks[ChessPiece::BLACK]) |
+        (Attacks::knightAttacks(square) & pieceMasks[Mailbox::KNIGHT]) |
+        (Attacks::kingAttacks(square) & pieceMasks[Mailbox::KING]) |
+        (Attacks::bishopAttacks(square, occupied) & diagonals) |
+        (Attacks::rookAttacks(square, occupied) & lines);
+}
+
+/**
+ * @brief Determines whether the king of the player to move is attacked
+ * @return True if the player to move has a king and it is in check. False otherwise.
+ */
+bool ChessBoard::isInCheck() const {
+    ChessPiece::Color us = sideToMove();
+    Attacks::Mask king = pieceMasks[Mailbox::KING] & colorMasks[us];
+    if (!king) { return false; }
+
+    return attackersTo(__builtin_ctzll(king), colorMasks[0] | colorMasks[1]) & colorMasks[us ^ 1];
+}
+
+/**
+ * @brief Finds the pieces of a color pinned to their king
+ * @param king A const reference to the square of the king
+ * @param color A const reference to the ChessPiece::Color of the king
+ * @return The mask of the pieces of `color` that stand alone between the king and an enemy rook, bishop or queen
+ */
+Attacks::Mask ChessBoard::pinnedPieces(const int& king, const ChessPiece::Color& color) const {
+    Attacks::Mask occupied = colorMasks[0] | colorMasks[1];
+
+    // The enemy sliders that would attack the king on an empty board
+    Attacks::Mask snipers = ((Attacks::rookAttacks(king, 0) & (pieceMasks[Mailbox::ROOK] | pieceMasks[Mailbox::QUEEN])) |
+        (Attacks::bishopAttacks(king, 0) & (pieceMasks[Mailbox::BISHOP] | pieceMasks[Mailbox::QUEEN]))) & colorMasks[color ^ 1];
+
+    Attacks::Mask pinned = 0;
+    while (snipers) {
+        Attacks::Mask blockers = Attacks::between(king, __builtin_ctzll(snipers)) & occupied;
+        snipers &= snipers - 1;
+
+        // A single blocker of our color is pinned
+        if (blockers && !(blockers & (blockers - 1))) { pinned |= blockers & colorMasks[color]; }
+    }
+
+    return pinned;
+}
+
+/**
+ * @brief Appends the castling moves of the side to move
+ * @param moves A (non-const) reference to the MoveList to append to
+ * @param color A const reference to the ChessPiece::Color of the side to move
+ */
+void ChessBoard::generateCastles(MoveList& moves, const ChessPiece::Color& color) const {
+    uint8_t rights = color == ChessPiece::WHITE ? castlingRights() >> 2 : castlingRights() & 0x3;
+    if (!rights) { return; }
+
+    int row = color == ChessPiece::WHITE ? BOARD_LENGTH - 1 : 0;
+    int king = Mailbox::square(row, KING_COLUMN);
+    Attacks::Mask occupied = colorMasks[0] | colorMasks[1];
+    Attacks::Mask enemies = colorMasks[color ^ 1];
+
+    for (const int& step : {-1, 1}) {
+        if (!(rights & (step < 0 ? BLACK_KING_CASTLE : BLACK_QUEEN_CASTLE))) { continue; }
+
+        // Every cell between the king and its rook is empty
+        int rook = Mailbox::square(row, step < 0 ? 0 : BOARD_LENGTH - 1);
+        if (Attacks::between(king, rook) & occupied) { continue; }
+
+        // The king does not castle out of, through, or into check
+        bool safe = true;
+        for (int col = KING_COLUMN; col != KING_COLUMN + 3 * step && safe; col += step) {
+            safe = !(attackersTo(Mailbox::square(row, col), occupied) & enemies);
+        }
+
+        if (safe) { moves.push(Move(king, king + 2 * step, step < 0 ? Move::KING_CASTLE : Move::QUEEN_CASTLE)); }
+    }
+}
+
+/**
+ * @brief Generates the moves of the side to move
+ * @param moves A (non-const) reference to the MoveList that receives the moves (it is cleared first)
+ * @param legal A const reference to a boolean, true to drop the moves that leave the king in check
+ */
+void ChessBoard::generateMoves(MoveList& moves, const bool& legal) const {
+    moves.clear();
+
+    const ChessPiece::Color us = sideToMove();
+    const Attacks::Mask ours = colorMasks[us];
+    const Attacks::Mask theirs = colorMasks[us ^ 1];
+    const Attacks::Mask occupied = ours | theirs;
+
+    const Attacks::Mask kings = pieceMasks[Mailbox::KING] & ours;
+    const int king = kings ? __builtin_ctzll(kings) : -1;
+
+    // The squares the other pieces may move to, and the pieces that may only move along their pin
+    Attacks::Mask targets = ~ours;
+    Attacks::Mask pinned = 0;
+
+    if (king != -1) {
+        Attacks::Mask checkers = legal ? attackersTo(king, occupied) & theirs : 0;
+
+        // The king may not step onto an attacked square, including one behind it on the line of a slider checking it
+        Attacks::Mask withoutKing = occupied ^ Attacks::squareMask(king);
+        for (Attacks::Mask steps = Attacks::kingAttacks(king) & ~ours; steps; steps &= steps - 1) {
+            int to = __builtin_ctzll(steps);
+            if (legal && (attackersTo(to, withoutKing) & theirs)) { continue; }
+
+            moves.push(Move(king, to, (theirs & Attacks::squareMask(to)) ? Move::CAPTURE : Move::QUIET));
+        }
+
+        // Only the king can answer a double check
+        if (checkers & (checkers - 1)) { return; }
+
+        if (checkers) { 
+            // Block the check, or capture the checking piece
+            targets &= Attacks::between(king, __builtin_ctzll(checkers)) | checkers;
+        } else {
+            generateCastles(moves, us);
+        }
+
+        if (legal) { pinned = pinnedPieces(king, us); }
+    }
+
+    // Appends a move to each of the squares reached by the piece on `from`
+    auto addMoves = [&](const int& from, Attacks::Mask reached) {
+        reached &= targets;
+        if (pinned & Attacks::squareMask(from)) { reached &= Attacks::line(king, from); }
+
+        for (; reached; reached &= reached - 1) {
+            int to = __builtin_ctzll(reached);
+            moves.push(Move(from, to, (theirs & Attacks::squareMask(to)) ? Move::CAPTURE : Move::QUIET));
+        }
+    };
+
+    for (Attacks::Mask pieces = pieceMasks[Mailbox::KNIGHT] & ours; pieces; pieces &= pieces - 1) {
+        int from = __builtin_ctzll(pieces);
+        addMoves(from, Attacks::knightAttacks(from));
+    }
+    for (Attacks::Mask pieces = pieceMasks[Mailbox::BISHOP] & ours; pieces; pieces &= pieces - 1) {
+        int from = __builtin_ctzll(pieces);
+        addMoves(from, Attacks::bishopAttacks(from, occupied));
+    }
+    for (Attacks::Mask pieces = pieceMasks[Mailbox::ROOK] & ours; pieces; pieces &= pieces - 1) {
+        int from = __builtin_ctzll(pieces);
+        addMoves(from, Attacks::rookAttacks(from, occupied));
+    }
+    for (Attacks::Mask pieces = pieceMasks[Mailbox::QUEEN] & ours; pieces; pieces &= pieces - 1) {
+        int from = __builtin_ctzll(pieces);
+        addMoves(from, Attacks::queenAttacks(from, occupied));
+    }
+
+    // Extra kings (never in a real game) move like the king they are not
+    for (Attacks::Mask pieces = kings & (kings - 1); pieces; pieces &= pieces - 1) {
+        int from = __builtin_ctzll(pieces);
+        addMoves(from, Attacks::kingAttacks(from));
+    }
+
+    // Pawns: BLACK pawns move up (+1 row), WHITE pawns move down (-1 row)
+    const bool movingUp = us == ChessPiece::BLACK;
+    const int forward = movingUp ? BOARD_LENGTH : -BOARD_LENGTH;
+    const int lastRow = movingUp ? BOARD_LENGTH - 1 : 0;
+
+    for (Attacks::Mask pawns = pieceMasks[Mailbox::PAWN] & ours; pawns; pawns &= pawns - 1) {
+        int from = __builtin_ctzll(pawns);
+
+        Attacks::Mask reached = Attacks::pawnAttacks(from, movingUp) & theirs;
+        int push = from + forward;
+        if (push >= 0 && push < Mailbox::SQUARES && !(occupied & Attacks::squareMask(push))) {
+            reached |= Attacks::squareMask(push);
+
+            // A pawn that has not moved may double jump over an empty cell (see Pawn::canDoubleJump)
+            int jump = push + forward;
+            if (!Mailbox::hasMoved(mailbox[from]) && jump >= 0 && jump < Mailbox::SQUARES && !(occupied & Attacks::squareMask(jump))) {
+                reached |= Attacks::squareMask(jump);
+            }
+        }
+
+        reached &= targets;
+        if (pinned & Attacks::squareMask(from)) { reached &= Attacks::line(king, from); }
+
+        for (; reached; reached &= reached - 1) {
+            int to = __builtin_ctzll(reached);
+            bool capture = theirs & Attacks::squareMask(to);
+
+            // A pawn reaching the last row promotes (see Pawn::canPromote)
+            if (to / BOARD_LENGTH == lastRow) {
+                for (const PieceType& promotion : {PieceType::QUEEN, PieceType::ROOK, PieceType::BISHOP, PieceType::KNIGHT}) {
+                    moves.push(Move::promotion(from, to, promotion, capture));
+                }
+            } else if (capture) {
+                moves.push(Move(from, to, Move::CAPTURE));
+            } else {
+                moves.push(Move(from, to, to == from + 2 * forward ? Move::DOUBLE_PUSH : Move::QUIET));
+            }
+        }
+    }
+
+    // En passant removes a pawn beside the capturing one, which may uncover the king along its row: so each capture is tested on the board it leaves
+    if (enPassantSquare != -1) {
+        int captured = enPassantSquare - forward;
+        Attacks::Mask capturers = Attacks::pawnAttacks(enPassantSquare, !movingUp) & pieceMasks[Mailbox::PAWN] & ours;
+
+        for (; capturers; capturers &= capturers - 1) {
+            int from = __builtin_ctzll(capturers);
+
+            if (legal && king != -1) {
+                Attacks::Mask after = (occupied ^ Attacks::squareMask(from) ^ Attacks::squareMask(captured)) | Attacks::squareMask(enPassantSquare);
+                if (attackersTo(king, after) & theirs & ~Attacks::squareMask(captured)) { continue; }
             }
-        };
 
-        std::vector<std::string> inner_pieces = {"ROOK", "KNIGHT", "BISHOP", "KING", "QUEEN", "BISHOP", "KNIGHT", "ROOK"};
-        for (size_t i = 0; i < BOARD_LENGTH; i++) {
-            add_mirrored(i, "PAWN");
-            add_mirrored(i, inner_pieces[i]);
+            moves.push(Move(from, enPassantSquare, Move::EN_PASSANT));
         }
     }
+}
 
 /**
- * @brief Constructs a ChessBoard object with a given board configuration and player turn.
- * 
- * @param instance A 2D vector representing a board state, where each element is a pointer to a ChessPiece.
- * @param p1Turn A boolean indicating whether it's player one's turn. True for player one, false for player two.
+ * @brief Generates every pseudo-legal move of the player to move: moves that follow the movement of their piece,
+ *      but may leave their own king in check. Castling is only generated when it is legal.
+ * @note BLACK pawns move up and WHITE pawns move down, as set up by ChessBoard(). A pawn may double jump while it 
+ *      has not moved (see Pawn::canDoubleJump), and promotes on the last row it moves towards (see Pawn::canPromote).
  * 
- * @post Initializes the board layout, sets player one's color to "BLACK" and player two's color to "WHITE".
+ * @param moves A (non-const) reference to the MoveList that receives the moves (it is cleared first)
  */
-ChessBoard::ChessBoard(const std::vector<std::vector<ChessPiece*>>& instance, const bool& p1Turn)
- : playerOneTurn{p1Turn}, p1_color{"BLACK"}, p2_color{"WHITE"}, board{instance}{}
+void ChessBoard::generatePseudoLegalMoves(MoveList& moves) const {
+    generateMoves(moves, false);
+}
 
 /**
- * @brief Gets the ChessPiece (if any) at (row, col) on the board
+ * @brief Generates every legal move of the player to move. 
  * 
- * @param row The row of the cell
- * @param col The column of the cell
- * @return ChessPiece* A pointer to the ChessPiece* at the cell specified by (row, col) on the board
+ * Moves that would leave the king in check are never generated: the pieces giving check and the pieces 
+ * pinned to the king are found once, and every target is masked by the squares that block or capture 
+ * the check, and by the line of the pin. No move is made to test it.
+ * @note Pawns, double jumps and promotions behave as in generatePseudoLegalMoves.
+ * 
+ * @param moves A (non-const) reference to the MoveList that receives the moves (it is cleared first)
  */
-ChessPiece* ChessBoard::getCell(const int& row, const int& col) const {
-    return board[row][col];
+void ChessBoard::generateLegalMoves(MoveList& moves) const {
+    generateMoves(moves, true);
 }
 
 /**
  * @brief Destructor. 
- * @post Deallocates all ChessPiece pointers stored on the board at time of deletion. 
+ * @post Deallocates all ChessPiece pointers handed out by getCell. 
  */
 ChessBoard::~ChessBoard() {
-    for (int i = 0; i < BOARD_LENGTH; i++) {
-        for (int j = 0; j < BOARD_LENGTH; j++) {
-            if (!board[i][j]) { continue; }
-            delete board[i][j];
-            board[i][j] = nullptr;
-        }
-    }
+    clearPieceCache();
 }
 
 /**
  * @brief Finds all possible solutions to the 8-queens problem.
  * 
+ * @param engine A const reference to the QueenEngine used for the search. BITMASK by default.
  * @return A vector of CharacterBoard objects, 
  *         each representing a unique solution 
  *         to the 8-queens problem.
  */
-std::vector<ChessBoard::CharacterBoard> ChessBoard::findAllQueenPlacements() {
+std::vector<ChessBoard::CharacterBoard> ChessBoard::findAllQueenPlacements(const QueenEngine& engine) {
+    return findAllQueenPlacements(BOARD_LENGTH, engine);
+}
+
+/**
+ * @brief Finds all possible solutions to the n-queens problem.
+ * @note The PIECES engine is limited to boards of at most BOARD_LENGTH, larger boards are always solved with BITMASK.
+ * 
+ * @param n A const reference to an integer representing the number of rows & columns of the board, in [1, MAX_QUEENS_LENGTH]
+ * @param engine A const reference to the QueenEngine used for the search. BITMASK by default.
+ * @param threads A const reference to the number of worker threads used by the PARALLEL engine. If not positive, the hardware concurrency is used.
+ * @return A vector of n x n CharacterBoard objects, each representing a solution to the n-queens problem.
+ *         Empty if n is out of range.
+ */
+std::vector<ChessBoard::CharacterBoard> ChessBoard::findAllQueenPlacements(const int& n, const QueenEngine& engine, const int& threads) {
     std::vector<CharacterBoard> allSolutions;
-    std::vector<std::vector<ChessPiece*>> board(8, std::vector<ChessPiece*>(8, nullptr));
-    std::vector<Queen*> queens;
+    if (n < 1 || n > MAX_QUEENS_LENGTH) { return allSolutions; }
+
+    if (engine == QueenEngine::PIECES && n <= BOARD_LENGTH) {
+        std::vector<std::vector<ChessPiece*>> board(n, std::vector<ChessPiece*>(n, nullptr));
+        std::vector<Queen*> queens;
+
+        queenHelper(n, 0, board, queens, allSolutions);
 
-    queenHelper(0, board, queens, allSolutions);
+        return allSolutions;
+    }
+
+    for (const QueenPlacement& solution : findAllQueenSolutions(n, engine, threads)) {
+        allSolutions.push_back(solution.toCharacterBoard());
+    }
 
     return allSolutions; 
 
 }
 
 /**
- * @brief A STATIC helper function for recursively solving the 8-queens problem.
+ * @brief Finds all possible solutions to the n-queens problem, in their compact form.
+ * @note The PIECES engine builds CharacterBoards, which are converted back to QueenPlacements.
+ * 
+ * @param n A const reference to an integer representing the number of rows & columns of the board, in [1, MAX_QUEENS_LENGTH]
+ * @param engine A const reference to the QueenEngine used for the search. BITMASK by default.
+ * @param threads A const reference to the number of worker threads used by the PARALLEL engine. If not positive, the hardware concurrency is used.
+ * @return A vector of QueenPlacement objects, each representing a solution to the n-queens problem.
+ *         Empty if n is out of range.
+ */
+std::vector<QueenPlacement> ChessBoard::findAllQueenSolutions(const int& n, const QueenEngine& engine, const int& threads) {
+    std::vector<QueenPlacement> allSolutions;
+    if (n < 1 || n > MAX_QUEENS_LENGTH) { return allSolutions; }
+
+    if (engine == QueenEngine::PIECES && n <= BOARD_LENGTH) {
+        for (const CharacterBoard& board : findAllQueenPlacements(n, engine)) {
+            allSolutions.push_back(QueenPlacement::fromCharacterBoard(board));
+        }
+        return allSolutions;
+    }
+
+    if (engine == QueenEngine::PARALLEL) {
+        WorkStealingPool pool(threads);
+        std::vector<QueenPrefix> prefixes = splitQueenSearch(n, pool.size());
+
+        // Each worker keeps the solutions of every subproblem it solved, tagged with the subproblem's index
+        std::vector<std::vector<std::pair<size_t, std::vector<QueenPlacement>>>> workerSolutions(pool.size());
+        std::vector<WorkStealingPool::Task> tasks;
+        for (size_t i = 0; i < prefixes.size(); i++) {
+            tasks.push_back([&, i] (const int& worker) {
+                QueenPrefix prefix = prefixes[i];
+                std::vector<QueenPlacement> solutions;
+                queenBitmaskHelper(n, prefix.columns, prefix.rows, prefix.upDiagonals, prefix.downDiagonals, prefix.placement, collectInto(solutions));
+                workerSolutions[worker].emplace_back(i, std::move(solutions));
+            });
+        }
+        pool.run(tasks);
+
+        // Merge in subproblem order, which is the order of the sequential search
+        std::vector<std::vector<QueenPlacement>*> bySubproblem(prefixes.size());
+        for (auto& buffer : workerSolutions) {
+            for (auto& solved : buffer) { bySubproblem[solved.first] = &solved.second; }
+        }
+        for (std::vector<QueenPlacement>* solutions : bySubproblem) {
+            allSolutions.insert(allSolutions.end(), solutions->begin(), solutions->end());
+        }
+        return allSolutions;
+    }
+
+    if (engine == QueenEngine::SYMMETRIC) {
+        for (const QueenPlacement& unique : findUniqueQueenSolutions(n)) {
+            std::vector<QueenPlacement> orbit = expandQueenOrbit(unique);
+            allSolutions.insert(allSolutions.end(), orbit.begin(), orbit.end());
+        }
+
+        // Restore the order of the sequential search
+        std::sort(allSolutions.begin(), allSolutions.end());
+        return allSolutions;
+    }
+
+    QueenPlacement placement(n);
+    queenBitmaskHelper(n, 0, 0, 0, 0, placement, collectInto(allSolutions));
+    return allSolutions;
+}
+
+/**
+ * @brief Counts the solutions to the n-queens problem without building any boards.
+ * @note The PIECES engine has no counting-only search, so it counts the boards found by findAllQueenPlacements.
+ * 
+ * @param n A const reference to an integer representing the number of rows & columns of the board, in [1, MAX_QUEENS_LENGTH]
+ * @param engine A const reference to the QueenEngine used for the search. BITMASK by default.
+ * @param threads A const reference to the number of worker threads used by the PARALLEL engine. If not positive, the hardware concurrency is used.
+ * @return The number of solutions to the n-queens problem. 0 if n is out of range.
+ */
+uint64_t ChessBoard::countQueenPlacements(const int& n, const QueenEngine& engine, const int& threads) {
+    if (n < 1 || n > MAX_QUEENS_LENGTH) { return 0; }
+
+    if (engine == QueenEngine::PIECES) { return findAllQueenPlacements(n, engine).size(); }
+
+    if (engine == QueenEngine::BITMASK || (engine == QueenEngine::SYMMETRIC && n == 1)) { return queenCountHelper(n, 0, 0, 0, 0); }
+
+    if (engine == QueenEngine::SYMMETRIC) {
+        // Every solution of the fundamental domain stands for itself and its flip
+        uint64_t count = 0;
+        for (const QueenPrefix& prefix : fundamentalQueenPrefixes(n)) {
+            count += queenCountHelper(n, prefix.columns, prefix.rows, prefix.upDiagonals, prefix.downDiagonals);
+        }
+        return 2 * count;
+    }
+
+    WorkStealingPool pool(threads);
+    std::vector<QueenPrefix> prefixes = splitQueenSearch(n, pool.size());
+
+    std::vector<uint64_t> workerCounts(pool.size(), 0);
+    std::vector<WorkStealingPool::Task> tasks;
+    for (const QueenPrefix& prefix : prefixes) {
+        tasks.push_back([&n, &prefix, &workerCounts] (const int& worker) {
+            workerCounts[worker] += queenCountHelper(n, prefix.columns, prefix.rows, prefix.upDiagonals, prefix.downDiagonals);
+        });
+    }
+    pool.run(tasks);
+
+    uint64_t count = 0;
+    for (const uint64_t& c : workerCounts) { count += c; }
+    return count;
+}
+
+/**
+ * @brief Streams the solutions to the n-queens problem to a visitor as soon as they are found.
+ * 
+ * Solutions arrive in the order of the sequential search, and only the placement being built is kept in memory, 
+ * no matter how many solutions exist. The visitor can stop the search early by returning false, 
+ * for example once it has received the first k solutions.
+ * 
+ * @param n A const reference to an integer representing the number of rows & columns of the board, in [1, MAX_QUEENS_LENGTH]
+ * @param visitor A const reference to a function receiving each solution, returning false to stop the search
+ * @return The number of solutions handed to the visitor. 0 if n is out of range.
+ */
+uint64_t ChessBoard::visitQueenSolutions(const int& n, const QueenVisitor& visitor) {
+    uint64_t visited = 0;
+    if (n < 1 || n > MAX_QUEENS_LENGTH) { return visited; }
+
+    QueenPlacement placement(n);
+    queenBitmaskHelper(n, 0, 0, 0, 0, placement, [&visitor, &visited] (const QueenPlacement& solution) {
+        visited++;
+        return visitor(solution);
+    });
+
+    return visited;
+}
+
+/**
+ * @brief A STATIC helper function that lists every valid placement of queens in the first `depth` columns.
+ * 
+ * @param n A const reference to an integer representing the number of rows & columns of the board
+ * @param depth A const reference to the number of columns to fill, less than n
+ * @return A vector of QueenPrefix objects in the order the sequential search visits them
+ */
+std::vector<ChessBoard::QueenPrefix> ChessBoard::queenPrefixes(const int& n, const int& depth) {
+    std::vector<QueenPrefix> prefixes = { QueenPrefix{0, 0, 0, 0, QueenPlacement(n)} };
+    const uint32_t all_rows = (1u << n) - 1;
+
+    // Extend every prefix by one column at a time, keeping rows in increasing order
+    for (int col = 0; col < depth; col++) {
+        std::vector<QueenPrefix> extended;
+        for (const QueenPrefix& prefix : prefixes) {
+            uint32_t available = ~(prefix.rows | prefix.upDiagonals | prefix.downDiagonals) & all_rows;
+            while (available) {
+                uint32_t bit = available & -available;
+                available ^= bit;
+
+                QueenPrefix next{prefix.rows | bit, ((prefix.upDiagonals | bit) << 1) & all_rows, (prefix.downDiagonals | bit) >> 1, col + 1, prefix.placement};
+                next.placement.setRow(col, __builtin_ctz(bit));
+                extended.push_back(next);
+            }
+        }
+        prefixes = std::move(extended);
+    }
+
+    return prefixes;
+}
+
+/**
+ * @brief A STATIC helper function that splits the n-queens search into prefix subproblems for a pool of workers.
+ * 
+ * The prefix depth grows until there are enough subproblems to keep every worker busy after the uneven ones finish.
+ * 
+ * @param n A const reference to an integer representing the number of rows & columns of the board
+ * @param threads A const reference to the number of workers that will share the subproblems
+ * @return A vector of QueenPrefix objects in the order the sequential search visits them
+ */
+std::vector<ChessBoard::QueenPrefix> ChessBoard::splitQueenSearch(const int& n, const int& threads) {
+    const size_t subproblems_per_thread = 16;
+
+    int depth = std::min(2, n - 1);
+    std::vector<QueenPrefix> prefixes = queenPrefixes(n, depth);
+    while (prefixes.size() < subproblems_per_thread * threads && depth < n - 2) {
+        prefixes = queenPrefixes(n, ++depth);
+    }
+
+    return prefixes;
+}
+
+/**
+ * @brief Finds one solution to the n-queens problem per group of solutions that are rotations / flips of each other.
+ * 
+ * Only the fundamental domain is searched, and no orbit is expanded. The solution kept for each group is the 
+ * one the sequential search finds first.
+ * 
+ * @param n A const reference to an integer representing the number of rows & columns of the board, in [1, MAX_QUEENS_LENGTH]
+ * @return A vector of n x n CharacterBoard objects, in the order the sequential search finds them. Empty if n is out of range.
+ */
+std::vector<ChessBoard::CharacterBoard> ChessBoard::findUniqueQueenPlacements(const int& n) {
+    std::vector<CharacterBoard> unique;
+    for (const QueenPlacement& solution : findUniqueQueenSolutions(n)) {
+        unique.push_back(solution.toCharacterBoard());
+    }
+
+    return unique;
+}
+
+/**
+ * @brief Finds one solution to the n-queens problem per group of solutions that are rotations / flips of each other, in their compact form.
+ * 
+ * @param n A const reference to an integer representing the number of rows & columns of the board, in [1, MAX_QUEENS_LENGTH]
+ * @return A vector of QueenPlacement objects, in the order the sequential search finds them. Empty if n is out of range.
+ */
+std::vector<QueenPlacement> ChessBoard::findUniqueQueenSolutions(const int& n) {
+    if (n == 1) { return findAllQueenSolutions(n); }
+
+    std::vector<QueenPlacement> candidates;
+    if (n < 1 || n > MAX_QUEENS_LENGTH) { return candidates; }
+
+    for (QueenPrefix& prefix : fundamentalQueenPrefixes(n)) {
+        queenBitmaskHelper(n, prefix.columns, prefix.rows, prefix.upDiagonals, prefix.downDiagonals, prefix.placement, collectInto(candidates));
+    }
+
+    // The first board of every orbit (in search order) always lies in the fundamental domain, 
+    // so keeping the candidates that come first in their own orbit keeps exactly one board per group.
+    std::vector<QueenPlacement> unique;
+    for (const QueenPlacement& candidate : candidates) {
+        if (canonicalPlacement(candidate) == candidate) {
+            unique.push_back(candidate);
+        }
+    }
+
+    return unique;
+}
+
+/**
+ * @brief Expands a board into every distinct board reachable by a
+ *      1) Rotation (clockwise: 0°, 90°, 180°, 270°)
+ *      2) Optionally followed by a flip across the vertical axis
+ * 
+ * @param board A const reference to a CharacterBoard holding one queen per row & column
+ * @return A vector of the distinct transformed boards (including `board` itself), in the order the queen searches find them
+ */
+std::vector<ChessBoard::CharacterBoard> ChessBoard::expandQueenOrbit(const CharacterBoard& board) {
+    std::vector<CharacterBoard> orbit;
+    for (const QueenPlacement& image : expandQueenOrbit(QueenPlacement::fromCharacterBoard(board))) {
+        orbit.push_back(image.toCharacterBoard());
+    }
+
+    return orbit;
+}
+
+/**
+ * @brief Expands a solution into every distinct solution reachable by a rotation, optionally followed by a flip across the vertical axis
+ * 
+ * @param placement A const reference to a QueenPlacement holding one queen per row
+ * @return A vector of the distinct transformed placements (including `placement` itself), in the order the queen searches find them
+ */
+std::vector<QueenPlacement> ChessBoard::expandQueenOrbit(const QueenPlacement& placement) {
+    std::array<QueenPlacement, Transform::SYMMETRY_COUNT> images = Transform::allImages(placement);
+    std::vector<QueenPlacement> orbit(images.begin(), images.end());
+
+    std::sort(orbit.begin(), orbit.end());
+    orbit.erase(std::unique(orbit.begin(), orbit.end()), orbit.end());
+
+    return orbit;
+}
+
+/**
+ * @brief A STATIC helper function that lists the prefixes covering the fundamental domain of the n-queens search.
+ * 
+ * Flipping a solution across the horizontal axis gives another, different, solution. So it is enough to search 
+ * solutions whose first-column queen lies in the lower half of the column, plus (for odd n) those whose first-column 
+ * queen is on the middle row and whose second-column queen lies in the lower half. Every other solution is the flip of one of these.
+ * @pre n is greater than 1 (a 1x1 board is its own flip)
+ * 
+ * @param n A const reference to an integer representing the number of rows & columns of the board
+ * @return A vector of QueenPrefix objects in the order the sequential search visits them
+ */
+std::vector<ChessBoard::QueenPrefix> ChessBoard::fundamentalQueenPrefixes(const int& n) {
+    const uint32_t all_rows = (1u << n) - 1;
+    const uint32_t lower_half = (1u << (n / 2)) - 1;
+
+    std::vector<QueenPrefix> prefixes;
+    for (int row = 0; row < n / 2; row++) {
+        uint32_t bit = 1u << row;
+        QueenPrefix prefix{bit, (bit << 1) & all_rows, bit >> 1, 1, QueenPlacement(n)};
+        prefix.placement.setRow(0, row);
+        prefixes.push_back(prefix);
+    }
+
+    if (n % 2 == 1) {
+        // The middle row is its own flip, so the second column decides which half the solution is in
+        uint32_t middle = 1u << (n / 2);
+        uint32_t upDiagonals = (middle << 1) & all_rows;
+        uint32_t downDiagonals = middle >> 1;
+        uint32_t available = ~(middle | upDiagonals | downDiagonals) & lower_half;
+
+        while (available) {
+            uint32_t bit = available & -available;
+            available ^= bit;
+
+            QueenPrefix prefix{middle | bit, ((upDiagonals | bit) << 1) & all_rows, (downDiagonals | bit) >> 1, 2, QueenPlacement(n)};
+            prefix.placement.setRow(0, n / 2);
+            prefix.placement.setRow(1, __builtin_ctz(bit));
+            prefixes.push_back(prefix);
+        }
+    }
+
+    return prefixes;
+}
+
+/**
+ * @brief A STATIC helper function that picks the representative of a solution's orbit
+ * 
+ * @param placement A const reference to a QueenPlacement holding one queen per row
+ * @return The smallest of the placements reachable by a rotation, optionally followed by a flip
+ */
+QueenPlacement ChessBoard::canonicalPlacement(const QueenPlacement& placement) {
+    std::array<QueenPlacement, Transform::SYMMETRY_COUNT> images = Transform::allImages(placement);
+    return *std::min_element(images.begin(), images.end());
+}
+
+/**
+ * @brief A STATIC helper function for recursively solving the n-queens problem.
  * 
  * This function places queens column by column, checks for valid placements,
  * and stores all valid board configurations in the provided list.
+ * @pre n is at most BOARD_LENGTH, since Queen::canMove only accepts targets on an 8x8 board
  * 
+ * @param n A const reference to an integer representing the number of rows & columns of the board
  * @param col A const reference to aninteger representing the current column being processed.
  * @param board A (non-const) reference to a 2D vector of ChessPiece*, representing the current board configuration
  * @param placedQueens A (non-const) reference to a vector storing Queen*, which represents the queens we've placed so far
  * @param allBoards A (non-const) reference to a vector of CharacterBoard objects storing all the solutions we've found thus far
  */
-void ChessBoard::queenHelper(const int& col, std::vector<std::vector<ChessPiece*>>& board, std::vector<Queen*>& placedQueens, std::vector<ChessBoard::CharacterBoard>& allBoards)
+void ChessBoard::queenHelper(const int& n, const int& col, std::vector<std::vector<ChessPiece*>>& board, std::vector<Queen*>& placedQueens, std::vector<ChessBoard::CharacterBoard>& allBoards)
 {
-    if (col == 8) {
-        ChessBoard::CharacterBoard solution(8, std::vector<char>(8, '*'));
+    if (col == n) {
+        ChessBoard::CharacterBoard solution(n, std::vector<char>(n, '*'));
         for (ChessPiece* q : placedQueens) {
             solution[q->getRow()][q->getColumn()] = 'Q';
         }
@@ -143,7 +1458,7 @@ void ChessBoard::queenHelper(const int& col, std::vector<std::vector<ChessPiece*
         return;
     }
 
-    for (int row = 0; row < 8; ++row) {
+    for (int row = 0; row < n; ++row) {
         bool isSafe = true;
 
         for (ChessPiece* q : placedQueens) {
@@ -158,7 +1473,7 @@ void ChessBoard::queenHelper(const int& col, std::vector<std::vector<ChessPiece*
             board[row][col] = newQueen;
             placedQueens.push_back(newQueen);
 
-            queenHelper(col + 1, board, placedQueens, allBoards);
+            queenHelper(n, col + 1, board, placedQueens, allBoards);
 
             placedQueens.pop_back();
             delete board[row][col];
@@ -167,6 +1482,91 @@ void ChessBoard::queenHelper(const int& col, std::vector<std::vector<ChessPiece*
     }
 
 }
+
+/**
+ * @brief A STATIC helper function for recursively solving the n-queens problem using bitmasks.
+ * 
+ * Bit i of each mask corresponds to row i of the current column. A row is available 
+ * if it is not set in any of the three masks, so each placement costs a few integer 
+ * operations and no allocations. Rows are tried in increasing order, so solutions are 
+ * found in the same order as queenHelper.
+ * 
+ * @param n A const reference to an integer representing the number of rows & columns of the board
+ * @param col A const reference to an integer representing the current column being processed.
+ * @param rows A const reference to a bitmask of the rows already holding a queen
+ * @param upDiagonals A const reference to a bitmask of the rows in this column attacked along an upward (row + 1, col + 1) diagonal
+ * @param downDiagonals A const reference to a bitmask of the rows in this column attacked along a downward (row - 1, col + 1) diagonal
+ * @param placement A (non-const) reference to a QueenPlacement storing the row of the queen placed in each column so far
+ * @param visitor A const reference to the QueenVisitor that receives every solution found
+ * @return False if the visitor stopped the search. True otherwise.
+ */
+bool ChessBoard::queenBitmaskHelper(const int& n, const int& col, const uint32_t& rows, const uint32_t& upDiagonals, const uint32_t& downDiagonals, QueenPlacement& placement, const QueenVisitor& visitor)
+{
+    if (col == n) {
+        return visitor(placement);
+    }
+
+    const uint32_t all_rows = (1u << n) - 1;
+    uint32_t available = ~(rows | upDiagonals | downDiagonals) & all_rows;
+
+    while (available) {
+        // Take the lowest available row first to match the order of queenHelper
+        uint32_t bit = available & -available;
+        available ^= bit;
+
+        placement.setRow(col, __builtin_ctz(bit));
+        if (!queenBitmaskHelper(n, col + 1, rows | bit, ((upDiagonals | bit) << 1) & all_rows, (downDiagonals | bit) >> 1, placement, visitor)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief A STATIC helper function that builds a visitor collecting every solution it receives
+ * 
+ * @param solutions A (non-const) reference to the vector the solutions are appended to. It must outlive the visitor.
+ * @return A QueenVisitor that appends each solution to `solutions` and never stops the search
+ */
+ChessBoard::QueenVisitor ChessBoard::collectInto(std::vector<QueenPlacement>& solutions) {
+    return [&solutions] (const QueenPlacement& solution) {
+        solutions.push_back(solution);
+        return true;
+    };
+}
+
+/**
+ * @brief A STATIC helper function for counting the solutions to the n-queens problem using bitmasks.
+ * 
+ * Performs the same search as queenBitmaskHelper, but never records a placement, so its memory use does not depend on the number of solutions.
+ * 
+ * @param n A const reference to an integer representing the number of rows & columns of the board
+ * @param col A const reference to an integer representing the current column being processed.
+ * @param rows A const reference to a bitmask of the rows already holding a queen
+ * @param upDiagonals A const reference to a bitmask of the rows in this column attacked along an upward diagonal
+ * @param downDiagonals A const reference to a bitmask of the rows in this column attacked along a downward diagonal
+ * @return The number of solutions that extend the current placement
+ */
+uint64_t ChessBoard::queenCountHelper(const int& n, const int& col, const uint32_t& rows, const uint32_t& upDiagonals, const uint32_t& downDiagonals)
+{
+    const uint32_t all_rows = (1u << n) - 1;
+    uint32_t available = ~(rows | upDiagonals | downDiagonals) & all_rows;
+
+    // Every available row in the last column completes a solution
+    if (col == n - 1) { return __builtin_popcount(available); }
+
+    uint64_t count = 0;
+    while (available) {
+        uint32_t bit = available & -available;
+        available ^= bit;
+
+        count += queenCountHelper(n, col + 1, rows | bit, ((upDiagonals | bit) << 1) & all_rows, (downDiagonals | bit) >> 1);
+    }
+
+    return count;
+}
+
 /**
  * @brief Groups similar chessboard configurations by transformations.
  * 
@@ -183,30 +1583,100 @@ void ChessBoard::queenHelper(const int& col, std::vector<std::vector<ChessPiece*
  */
 std::vector<std::vector<ChessBoard::CharacterBoard>> ChessBoard::groupSimilarBoards(const std::vector<CharacterBoard>& boards) {
     std::vector<std::vector<CharacterBoard>> result;
+    std::unordered_map<std::string, size_t> groupOf;    // Canonical key -> index of its group in result
 
-    for (auto board : boards) {
-        bool isSimilar = false;
+    for (const CharacterBoard& board : boards) {
+        auto found = groupOf.emplace(canonicalKey(board), result.size());
 
-        for (auto& group : result) {
-            CharacterBoard transformed = group[0];
+        // If no similar board was seen, the key is new and opens a new group
+        if (found.second) {
+            result.push_back({ board });
+        } else {
+            result[found.first->second].push_back(board);
+        }
+    }
 
-            for (int i = 0; i < 4; i++) {
-                if (board == transformed || board == Transform::flipAcrossVertical(transformed) || board == Transform::flipAcrossHorizontal(transformed)) {    
-                    group.push_back(board);
-                    isSimilar = true;
-                    break;
-                }
+    return result;
+}
+
+/**
+ * @brief A STATIC helper function that computes a key identifying a board up to rotations & flips.
+ * 
+ * A board is encoded as its n * n cells in row-major order. The key is the lexicographically 
+ * smallest encoding among the 8 boards reachable by a rotation, optionally followed by a flip, 
+ * so two boards share a key exactly when one is a transformation of the other.
+ * 8x8 boards holding only '*' and one other char are instead keyed by their smallest Transform::PackedBoard image.
+ * 
+ * @param board A const reference to a square CharacterBoard
+ * @return The canonical encoding of the board
+ */
+std::string ChessBoard::canonicalKey(const CharacterBoard& board) {
+    int n = board.size();
+
+    // 8x8 boards holding '*' and a single other char are keyed by their smallest packed image instead
+    if (n == BOARD_LENGTH) {
+        char filled = '*';
+        bool packable = true;
+        for (const std::vector<char>& row : board) {
+            for (const char& cell : row) {
+                if (cell == '*' || cell == filled) { continue; }
+                packable = packable && filled == '*';
+                filled = cell;
+            }
+        }
 
-                // Rotate 90° clockwise for next comparison
-                transformed = Transform::rotate(transformed);
+        if (packable) {
+            uint64_t smallest = ~0ull;
+            for (const Transform::PackedBoard& image : Transform::allImages(Transform::pack(board))) {
+                smallest = std::min(smallest, image.bits);
             }
 
-            if (isSimilar) break;
+            // 10 chars long, which no n * n encoding is, so packed and row-major keys never collide
+            std::string key(reinterpret_cast<const char*>(&smallest), sizeof(smallest));
+            key += filled;
+            key += '\0';
+            return key;
         }
+    }
 
-        // If no similar board found, create a new group
-        if (!isSimilar) {
-            result.push_back({ board });
+    // Find the smallest image by comparing views of the board, so no image is built until the winner is known
+    Transform::View<CharacterBoard> smallest(board);
+    for (const Transform::Symmetry& op : Transform::ALL_SYMMETRIES) {
+        Transform::View<CharacterBoard> transformed(board, op);
+        if (transformed.compare(smallest) < 0) { smallest = transformed; }
+    }
+
+    std::string key(n * n, '*');
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            key[i * n + j] = smallest(i, j);
+        }
+    }
+
+    return key;
+}
+
+/**
+ * @brief Groups similar n-queens solutions by transformations, in their compact form.
+ * 
+ * Solutions are similar if one is a rotation of the other, optionally followed by a flip. 
+ * Each solution is keyed by the smallest placement of its orbit, so grouping is linear in the number of solutions.
+ * 
+ * @param placements A const reference to a vector of QueenPlacement objects, each holding one queen per row
+ * @return A 2D vector of QueenPlacement objects, where each inner vector is a list of placements 
+ *         that are transformations of each other. Groups and their members keep the order of `placements`.
+ */
+std::vector<std::vector<QueenPlacement>> ChessBoard::groupSimilarPlacements(const std::vector<QueenPlacement>& placements) {
+    std::vector<std::vector<QueenPlacement>> result;
+    std::unordered_map<QueenPlacement, size_t, QueenPlacement::Hash> groupOf;
+
+    for (const QueenPlacement& placement : placements) {
+        auto found = groupOf.emplace(canonicalPlacement(placement), result.size());
+
+        if (found.second) {
+            result.push_back({ placement });
+        } else {
+            result[found.first->second].push_back(placement);
         }
     }
 
@@ -10,43 +10,276 @@
 #pragma once
 
 #include <vector>
+#include <cstdint>
+#include <functional>
+#include <string_view>
 #include "pieces_module.hpp"
+#include "QueenPlacement.hpp"
+#include "Mailbox.hpp"
+#include "Move.hpp"
+#include "Zobrist.hpp"
+#include "PieceSquare.hpp"
+#include "PackedPosition.hpp"
+#include "pieces/MoveRules.hpp"
 
 class ChessBoard {
     private:
         // Define board size (8x8)
-        static const int BOARD_LENGTH = 8;
+        static constexpr int BOARD_LENGTH = 8;
+
+        // The column both kings start on
+        static constexpr int KING_COLUMN = 3;
         
         bool playerOneTurn;
         
         std::string p1_color;
         std::string p2_color;
 
-        std::vector<std::vector<ChessPiece*>> board;
+        // The pieces on the board, one byte per square
+        Mailbox mailbox;
+
+        // The squares held by each piece type (indexed by PieceType, pieceMasks[NONE] is unused) and by each color (indexed by ChessPiece::Color), kept in step with mailbox
+        std::array<Attacks::Mask, 7> pieceMasks;
+        std::array<Attacks::Mask, 2> colorMasks;
+
+        // The square a pawn can capture en passant onto (the square skipped by the last double push, if an enemy pawn attacks it), -1 if there is none
+        int enPassantSquare;
+
+        // The Zobrist hash of the position, kept up to date by makeMove & unmakeMove
+        Zobrist::Key hash;
+
+        // The Zobrist hash of the pawns alone (no castling, en passant or side to move), keying the pawn structure cache of Evaluator
+        Zobrist::Key pawnHash;
+
+        // The summed PieceSquare scores of each color's pieces (indexed by ChessPiece::Color), and the game phase of the pieces on the board
+        std::array<PieceSquare::Score, 2> pieceSquareScores;
+        int gamePhase;
+
+        /**
+         * @brief Rebuilds pieceMasks, colorMasks, the hashes & the evaluation sums from the mailbox
+         */
+        void syncFromMailbox();
+
+        /**
+         * @brief Places a piece on an empty square, updating the mailbox, the masks, the hashes and the evaluation sums
+         * @param square A const reference to an empty square
+         * @param piece A const reference to the Piece code to place (not EMPTY)
+         */
+        void putPiece(const int& square, const Mailbox::Piece& piece);
+
+        /**
+         * @brief Removes the piece on a square, updating the mailbox, the masks, the hashes and the evaluation sums
+         * @param square A const reference to an occupied square
+         */
+        void removePiece(const int& square);
+
+        /**
+         * @brief Replaces the position with one given without its history, as FEN & PackedPosition give it.
+         * 
+         * Only the type & color of each piece are read from `placed`: the other flags are rebuilt. Pawns off their 
+         * starting row are flagged as moved, and kings & rooks are flagged as moved unless a castling right needs them. 
+         * A castling right whose king or rook is missing is dropped. The en passant square is only kept if a pawn can 
+         * capture onto it (as after makeMove).
+         * 
+         * @param placed A const reference to the pieces to place
+         * @param blackToMove A const reference to a boolean, true if BLACK is to move
+         * @param rights A const reference to the castling rights claimed, as a castlingRights mask
+         * @param skipped A const reference to the en passant square claimed, -1 if there is none
+         * @return True if the position was set. False if it does not have one king per color, has a pawn on a back row,
+         *      or `skipped` was not skipped by a double push of the player who just moved. The board is left unchanged.
+         * @post getCell builds new pieces for every square
+         */
+        bool setPosition(const Mailbox& placed, const bool& blackToMove, const uint8_t& rights, const int& skipped);
+
+        /**
+         * @brief Deletes the ChessPiece built by getCell for a square, since its piece changed
+         * @param square A const reference to a square
+         */
+        void dropCachedPiece(const int& square);
+
+        /**
+         * @brief Finds the pieces of a color pinned to their king
+         * @param king A const reference to the square of the king
+         * @param color A const reference to the ChessPiece::Color of the king
+         * @return The mask of the pieces of `color` that stand alone between the king and an enemy rook, bishop or queen
+         */
+        Attacks::Mask pinnedPieces(const int& king, const ChessPiece::Color& color) const;
+
+        /**
+         * @brief Appends the castling moves of the side to move
+         * @param moves A (non-const) reference to the MoveList to append to
+         * @param color A const reference to the ChessPiece::Color of the side to move
+         */
+        void generateCastles(MoveList& moves, const ChessPiece::Color& color) const;
+
+        /**
+         * @brief Generates the moves of the side to move
+         * @param moves A (non-const) reference to the MoveList that receives the moves (it is cleared first)
+         * @param legal A const reference to a boolean, true to drop the moves that leave the king in check
+         */
+        void generateMoves(MoveList& moves, const bool& legal) const;
+
+        // ChessPiece objects handed out by getCell, built the first time their square is read (nullptr until then)
+        mutable std::array<ChessPiece*, Mailbox::SQUARES> pieceCache;
+
+        /**
+         * @brief Deletes every ChessPiece built by getCell
+         * @post Every entry of pieceCache is nullptr
+         */
+        void clearPieceCache();
+
+        /**
+         * @brief Reads the piece on a cell of the mailbox, as the rules see it
+         * @pre (row, col) is on the board
+         * @return The MoveRules::Mover of the piece on (row, col) (of type PieceType::NONE if the cell is empty)
+         */
+        MoveRules::Mover moverAt(const int& row, const int& col) const;
 
         // Alias for readability
         typedef std::vector<std::vector<char>> CharacterBoard;
 
+        // Receives each queen solution as soon as it is found. Returning false stops the search.
+        typedef std::function<bool(const QueenPlacement&)> QueenVisitor;
+
         /**
-         * @brief A STATIC helper function for recursively solving the 8-queens problem.
+         * @brief A STATIC helper function for recursively solving the n-queens problem.
          * 
          * This function places queens column by column, checks for valid placements,
          * and stores all valid board configurations in the provided list.
+         * @pre n is at most BOARD_LENGTH, since Queen::canMove only accepts targets on an 8x8 board
          * 
+         * @param n A const reference to an integer representing the number of rows & columns of the board
          * @param col A const reference to aninteger representing the current column being processed.
          * @param board A (non-const) reference to a 2D vector of ChessPiece*, representing the current board configuration
          * @param placedQueens A (non-const) reference to a vector storing Queen*, which represents the queens we've placed so far
          * @param allBoards A (non-const) reference to a vector of CharacterBoard objects storing all the solutions we've found thus far
         */
-        static void queenHelper(const int& col, std::vector<std::vector<ChessPiece*>>& board, std::vector<Queen*>& placedQueens, std::vector<CharacterBoard>& allBoards);
+        static void queenHelper(const int& n, const int& col, std::vector<std::vector<ChessPiece*>>& board, std::vector<Queen*>& placedQueens, std::vector<CharacterBoard>& allBoards);
+
+        /**
+         * @brief A STATIC helper function for recursively solving the n-queens problem using bitmasks.
+         * 
+         * Bit i of each mask corresponds to row i of the current column. A row is available 
+         * if it is not set in any of the three masks, so each placement costs a few integer 
+         * operations and no allocations. Rows are tried in increasing order, so solutions are 
+         * found in the same order as queenHelper.
+         * 
+         * @param n A const reference to an integer representing the number of rows & columns of the board
+         * @param col A const reference to an integer representing the current column being processed.
+         * @param rows A const reference to a bitmask of the rows already holding a queen
+         * @param upDiagonals A const reference to a bitmask of the rows in this column attacked along an upward (row + 1, col + 1) diagonal
+         * @param downDiagonals A const reference to a bitmask of the rows in this column attacked along a downward (row - 1, col + 1) diagonal
+         * @param placement A (non-const) reference to a QueenPlacement storing the row of the queen placed in each column so far
+         * @param visitor A const reference to the QueenVisitor that receives every solution found
+         * @return False if the visitor stopped the search. True otherwise.
+        */
+        static bool queenBitmaskHelper(const int& n, const int& col, const uint32_t& rows, const uint32_t& upDiagonals, const uint32_t& downDiagonals, QueenPlacement& placement, const QueenVisitor& visitor);
+
+        /**
+         * @brief A STATIC helper function that builds a visitor collecting every solution it receives
+         * 
+         * @param solutions A (non-const) reference to the vector the solutions are appended to. It must outlive the visitor.
+         * @return A QueenVisitor that appends each solution to `solutions` and never stops the search
+        */
+        static QueenVisitor collectInto(std::vector<QueenPlacement>& solutions);
+
+        /**
+         * @brief A STATIC helper function for counting the solutions to the n-queens problem using bitmasks.
+         * 
+         * Performs the same search as queenBitmaskHelper, but never records a placement, so its memory use does not depend on the number of solutions.
+         * 
+         * @param n A const reference to an integer representing the number of rows & columns of the board
+         * @param col A const reference to an integer representing the current column being processed.
+         * @param rows A const reference to a bitmask of the rows already holding a queen
+         * @param upDiagonals A const reference to a bitmask of the rows in this column attacked along an upward diagonal
+         * @param downDiagonals A const reference to a bitmask of the rows in this column attacked along a downward diagonal
+         * @return The number of solutions that extend the current placement
+        */
+        static uint64_t queenCountHelper(const int& n, const int& col, const uint32_t& rows, const uint32_t& upDiagonals, const uint32_t& downDiagonals);
+
+        // A partial placement of the first few columns, used to split the queen search across threads
+        struct QueenPrefix {
+            uint32_t rows;
+            uint32_t upDiagonals;
+            uint32_t downDiagonals;
+            int columns;                // The number of columns filled
+            QueenPlacement placement;
+        };
+
+        /**
+         * @brief A STATIC helper function that lists every valid placement of queens in the first `depth` columns.
+         * 
+         * @param n A const reference to an integer representing the number of rows & columns of the board
+         * @param depth A const reference to the number of columns to fill, less than n
+         * @return A vector of QueenPrefix objects in the order the sequential search visits them
+         */
+        static std::vector<QueenPrefix> queenPrefixes(const int& n, const int& depth);
+
+        /**
+         * @brief A STATIC helper function that splits the n-queens search into prefix subproblems for a pool of workers.
+         * 
+         * The prefix depth grows until there are enough subproblems to keep every worker busy after the uneven ones finish.
+         * 
+         * @param n A const reference to an integer representing the number of rows & columns of the board
+         * @param threads A const reference to the number of workers that will share the subproblems
+         * @return A vector of QueenPrefix objects in the order the sequential search visits them
+         */
+        static std::vector<QueenPrefix> splitQueenSearch(const int& n, const int& threads);
+
+        /**
+         * @brief A STATIC helper function that lists the prefixes covering the fundamental domain of the n-queens search.
+         * 
+         * Flipping a solution across the horizontal axis gives another, different, solution. So it is enough to search 
+         * solutions whose first-column queen lies in the lower half of the column, plus (for odd n) those whose first-column 
+         * queen is on the middle row and whose second-column queen lies in the lower half. Every other solution is the flip of one of these.
+         * @pre n is greater than 1 (a 1x1 board is its own flip)
+         * 
+         * @param n A const reference to an integer representing the number of rows & columns of the board
+         * @return A vector of QueenPrefix objects in the order the sequential search visits them
+         */
+        static std::vector<QueenPrefix> fundamentalQueenPrefixes(const int& n);
+
+        /**
+         * @brief A STATIC helper function that picks the representative of a solution's orbit
+         * 
+         * @param placement A const reference to a QueenPlacement holding one queen per row
+         * @return The smallest of the placements reachable by a rotation, optionally followed by a flip
+         */
+        static QueenPlacement canonicalPlacement(const QueenPlacement& placement);
+
+        /**
+         * @brief A STATIC helper function that computes a key identifying a board up to rotations & flips.
+         * 
+         * A board is encoded as its n * n cells in row-major order. The key is the lexicographically 
+         * smallest encoding among the 8 boards reachable by a rotation, optionally followed by a flip, 
+         * so two boards share a key exactly when one is a transformation of the other.
+         * 8x8 boards holding only '*' and one other char are instead keyed by their smallest Transform::PackedBoard image.
+         * 
+         * @param board A const reference to a square CharacterBoard
+         * @return The canonical encoding of the board
+         */
+        static std::string canonicalKey(const CharacterBoard& board);
 
 
     public:
+        /**
+         * @brief Selects the search used by findAllQueenPlacements.
+         *  - PIECES:  Places a heap-allocated Queen per trial and validates it against every placed queen with Queen::canMove
+         *  - BITMASK: Tracks occupied rows and diagonals as bitmasks (see queenBitmaskHelper)
+         *  - PARALLEL: Splits the BITMASK search into prefix subproblems and solves them on a WorkStealingPool
+         *  - SYMMETRIC: Searches only the fundamental domain (see fundamentalQueenPrefixes), then expands the unique solutions into their orbits
+         * All engines produce identical results, in the same order.
+         */
+        enum class QueenEngine { PIECES, BITMASK, PARALLEL, SYMMETRIC };
+
+        // The largest board supported by the queen solvers (rows are tracked as bits of a 32-bit mask)
+        static constexpr int MAX_QUEENS_LENGTH = QueenPlacement::MAX_LENGTH;
+
         /**
          * Default constructor. 
          * @post The board is setup with the following restrictions:
-         * 1) board is initialized to a 8x8 2D vector of ChessPiece pointers
-         *      - ChessPiece derived classes are dynamically allocated and constructed as follows:
+         * 1) mailbox is initialized to the 8x8 starting position (no ChessPiece is allocated until getCell asks for it)
+         *      - Pieces are encoded as follows:
          *          - Pieces on the BOTTOM half of the board are set to be "moving up" | of color "BLACK"
          *          - Pieces on the UPPER half of the board are set to be NOT "moving up"| of color "WHITE"
          *          - Their row & col members reflect their position on the board
@@ -79,32 +312,356 @@ class ChessBoard {
          * @param p1Turn A boolean indicating whether it's player one's turn. True for player one, false for player two.
          * 
          * @post Initializes the board layout, sets player one's color to "BLACK" and player two's color to "WHITE".
+         *      The board takes ownership of the pieces in `board`: getCell returns them until the board is destroyed.
          */
         ChessBoard(const std::vector<std::vector<ChessPiece*>>& board, const bool& p1Turn);
 
+        /**
+         * @brief Copy constructor. Copies the 64-byte mailbox, without copying or allocating any ChessPiece.
+         * @param other A const reference to the ChessBoard to copy
+         */
+        ChessBoard(const ChessBoard& other);
+
+        /**
+         * @brief Copy assignment operator. Copies the 64-byte mailbox and discards the pieces built by getCell.
+         * @param other A const reference to the ChessBoard to copy
+         * @return A reference to this board
+         */
+        ChessBoard& operator=(const ChessBoard& other);
+
         /**
          * @brief Gets the ChessPiece (if any) at (row, col) on the board
          * 
          * @param row The row of the cell
          * @param col The column of the cell
          * @return ChessPiece* A pointer to the ChessPiece* at the cell specified by (row, col) on the board
+         * @note The piece is built from the mailbox the first time its cell is read, and is owned by the board. 
+         *      Changes made through the pointer are not written back to the board.
          */
         ChessPiece* getCell(const int& row, const int& col) const;
 
+        /**
+         * @brief Determines whether the piece on a cell can move to another cell, reading the mailbox directly 
+         *      (no ChessPiece is built and no virtual call is made)
+         * 
+         * @param row A const reference to the row of the moving piece
+         * @param col A const reference to the column of the moving piece
+         * @param target_row A const reference to the row of the target position
+         * @param target_col A const reference to the column of the target position
+         * @return True if there is a piece on (row, col) and it can move to the target position (see MoveRules::canMove). False otherwise.
+         */
+        bool canMove(const int& row, const int& col, const int& target_row, const int& target_col) const;
+
+        /**
+         * @brief Finds every cell the piece on a cell can move to, in one call (reading the mailbox directly)
+         * 
+         * @param row A const reference to the row of the moving piece
+         * @param col A const reference to the column of the moving piece
+         * @return A mask with bit (target_row * BOARD_LENGTH + target_col) set exactly when canMove(row, col, target_row, target_col) is true
+         */
+        Attacks::Mask reachableSquares(const int& row, const int& col) const;
+
+        /**
+         * @brief Everything makeMove changes that unmakeMove cannot work out from the move itself
+         */
+        struct UndoRecord {
+            Move move;
+            Mailbox::Piece moved;       // The moving piece, as it was on its from square
+            Mailbox::Piece captured;    // The captured piece, EMPTY if there is none
+            Mailbox::Piece rook;        // The castling Rook, as it was in its corner (EMPTY unless the move castles)
+            int8_t enPassantSquare;     // The en passant square before the move
+            Zobrist::Key hash;          // The hash before the move
+        };
+
+        // The castling rights, as bits of the mask returned by castlingRights
+        static constexpr uint8_t BLACK_KING_CASTLE = 1;
+        static constexpr uint8_t BLACK_QUEEN_CASTLE = 2;
+        static constexpr uint8_t WHITE_KING_CASTLE = 4;
+        static constexpr uint8_t WHITE_QUEEN_CASTLE = 8;
+
+        /**
+         * @brief Gets the color of the player to move
+         * @return ChessPiece::BLACK (player one) if playerOneTurn is true. ChessPiece::WHITE otherwise.
+         */
+        ChessPiece::Color sideToMove() const;
+
+        /**
+         * @brief Gets the square a pawn can capture en passant onto
+         * @return The square skipped by the last double push, -1 if the last move was not a double push
+         */
+        int getEnPassantSquare() const;
+
+        /**
+         * @brief Gets the castling rights of both players.
+         * 
+         * A side may castle towards a corner while its king is unmoved on column 3 of its back row, and the Rook in 
+         * that corner is unmoved with castle moves left (see Rook::canCastle). King side castling is towards column 0.
+         * 
+         * @return A mask of BLACK_KING_CASTLE, BLACK_QUEEN_CASTLE, WHITE_KING_CASTLE and WHITE_QUEEN_CASTLE
+         */
+        uint8_t castlingRights() const;
+
+        /**
+         * @brief Gets the squares held by the pieces of one color & type
+         * @param color A const reference to ChessPiece::BLACK or ChessPiece::WHITE
+         * @param type A const reference to a PieceType (NONE gives an empty mask)
+         * @return A mask with bit (row * BOARD_LENGTH + col) set for every piece of `color` and `type`
+         */
+        Attacks::Mask getPieces(const ChessPiece::Color& color, const PieceType& type) const;
+
+        /**
+         * @brief Finds every piece, of either color, attacking a square
+         * @param square A const reference to a square (row * BOARD_LENGTH + col)
+         * @param occupied A const reference to the mask of occupied squares that block rooks, bishops & queens
+         * @return The mask of the squares holding a piece that attacks `square`
+         */
+        Attacks::Mask attackersTo(const int& square, const Attacks::Mask& occupied) const;
+
+        /**
+         * @brief Determines whether the king of the player to move is attacked
+         * @return True if the player to move has a king and it is in check. False otherwise.
+         */
+        bool isInCheck() const;
+
+        /**
+         * @brief Generates every pseudo-legal move of the player to move: moves that follow the movement of their piece,
+         *      but may leave their own king in check. Castling is only generated when it is legal.
+         * @note BLACK pawns move up and WHITE pawns move down, as set up by ChessBoard(). A pawn may double jump while it 
+         *      has not moved (see Pawn::canDoubleJump), and promotes on the last row it moves towards (see Pawn::canPromote).
+         * 
+         * @param moves A (non-const) reference to the MoveList that receives the moves (it is cleared first)
+         */
+        void generatePseudoLegalMoves(MoveList& moves) const;
+
+        /**
+         * @brief Generates every legal move of the player to move. 
+         * 
+         * Moves that would leave the king in check are never generated: the pieces giving check and the pieces 
+         * pinned to the king are found once, and every target is masked by the squares that block or capture 
+         * the check, and by the line of the pin. No move is made to test it.
+         * @note Pawns, double jumps and promotions behave as in generatePseudoLegalMoves.
+         * 
+         * @param moves A (non-const) reference to the MoveList that receives the moves (it is cleared first)
+         */
+        void generateLegalMoves(MoveList& moves) const;
+
+        /**
+         * @brief Plays a move on the board, in place.
+         * 
+         * The moved piece is flagged as moved. A promoted pawn becomes the piece named by the move, and castling 
+         * spends one of the Rook's castle moves. The hash is updated with a few XORs, without reading the rest of the board.
+         * @pre `move` was generated for this position (see generateLegalMoves / generatePseudoLegalMoves)
+         * @post The other player is to move. getCell builds new pieces for the squares the move changed.
+         * 
+         * @param move A const reference to the Move to play
+         * @return The UndoRecord that takes the board back to this position (see unmakeMove)
+         */
+        UndoRecord makeMove(const Move& move);
+
+        /**
+         * @brief Takes back the last move played, restoring the board exactly as it was before it
+         * @pre `undo` was returned by the last makeMove not yet taken back
+         * 
+         * @param undo A const reference to the UndoRecord of the move to take back
+         */
+        void unmakeMove(const UndoRecord& undo);
+
+        /**
+         * @brief Gets the Zobrist hash of the position: the pieces, the player to move, the castling rights and the en passant column
+         * @return The 64-bit hash. Two boards holding the same position have the same hash.
+         */
+        Zobrist::Key getHash() const;
+
+        /**
+         * @brief Gets the Zobrist hash of the pawns alone: the same keys as getHash, for pawns only
+         * @return The 64-bit hash. Two boards with the same pawns on the same squares have the same pawn hash.
+         */
+        Zobrist::Key getPawnHash() const;
+
+        /**
+         * @brief Gets the material & piece-square score of a player's pieces, kept up to date by makeMove & unmakeMove
+         * @param color A const reference to the color of the player: ChessPiece::BLACK or ChessPiece::WHITE
+         * @return The sum of PieceSquare::score over the player's pieces
+         */
+        PieceSquare::Score getPieceSquareScore(const int& color) const;
+
+        /**
+         * @brief Gets the game phase: the sum of PieceSquare::phaseOf over every piece on the board
+         * @return PieceSquare::MAX_PHASE with all the minor & major pieces of the opening, less as they are traded (more after promotions)
+         */
+        int getGamePhase() const;
+
+        // A buffer this long holds any FEN written by writeFen, its terminating '\0' included
+        static constexpr size_t FEN_BUFFER_SIZE = 96;
+
+        /**
+         * @brief Replaces the position with one read from Forsyth-Edwards Notation, without allocating.
+         * 
+         * The standard board maps onto this one rotated: rank r is row 8 - r and file f is column 'h' - f, so WHITE
+         * holds rows 6 & 7 and BLACK's pawns move up. Pawns off their starting row are flagged as moved, and kings 
+         * & rooks are flagged as moved unless a castling right needs them. A castling right whose king or rook is 
+         * missing is dropped. The en passant square is only kept if a pawn can capture onto it (as after makeMove).
+         * The halfmove clock & fullmove number are optional and ignored: the board keeps no move counters.
+         * 
+         * @param fen A const reference to the FEN, such as "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"
+         * @return True if the position was read. False if `fen` is malformed, does not have one king per color and 
+         *      no pawn on a back rank, or names an en passant square no double push of the player who just moved could 
+         *      have skipped (it must be empty, on the skipped rank, in front of that player's pawn). The board is left unchanged.
+         * @post getCell builds new pieces for every square
+         */
+        bool setFromFen(const std::string_view& fen);
+
+        /**
+         * @brief Writes the position in Forsyth-Edwards Notation, without allocating
+         * @param buffer A pointer to the first character to write
+         * @param capacity A const reference to the number of characters `buffer` holds. FEN_BUFFER_SIZE is always enough.
+         * @return The length of the FEN, not counting the '\0' written after it. 0 if it does not fit (nothing is written).
+         * @note The halfmove clock & fullmove number are written as "0 1"
+         */
+        size_t writeFen(char* buffer, const size_t& capacity) const;
+
+        /**
+         * @brief Gets the position in Forsyth-Edwards Notation (see writeFen)
+         * @return The FEN of the position
+         */
+        std::string toFen() const;
+
+        /**
+         * @brief Replaces the position with a packed one, without allocating
+         * 
+         * The flags the packed format does not hold are rebuilt as setFromFen rebuilds them.
+         * 
+         * @param packed A const reference to the PackedPosition
+         * @return True if the position was read. False if it holds an invalid piece code or en passant square, or does not
+         *      have one king per color and no pawn on a back rank. The board is left unchanged.
+         * @post getCell builds new pieces for every square
+         */
+        bool setFromPacked(const PackedPosition& packed);
+
+        /**
+         * @brief Packs the position into 32 bytes
+         * @param packed A (non-const) reference to the PackedPosition to write. Its reserved bytes are zeroed.
+         * @return True if the position was packed. False if it holds more than PackedPosition::MAX_PIECES pieces (`packed` is left unchanged).
+         */
+        bool writePacked(PackedPosition& packed) const;
+
+        /**
+         * @brief Finds the legal move written in Standard Algebraic Notation, such as "Nbd7", "exd5", "e8=Q+" or "O-O-O"
+         * 
+         * Squares are read as in setFromFen. Check & annotation suffixes ("+", "#", "!", "?") are ignored, castling may be 
+         * written with zeros, and the "=" of a promotion may be left out.
+         * 
+         * @param san A const reference to the move
+         * @return The legal Move it names. Move::none() if it is malformed, names no legal move, or is ambiguous.
+         */
+        Move moveFromSan(const std::string_view& san) const;
+
+        /**
+         * @brief Gets the flat representation of the board
+         * @return A const reference to the Mailbox holding a piece code per square
+         */
+        const Mailbox& getMailbox() const;
+
         /**
          * @brief Destructor. 
-         * @post Deallocates all ChessPiece pointers stored on the board at time of deletion. 
+         * @post Deallocates all ChessPiece pointers handed out by getCell. 
          */
         ~ChessBoard();
 
         /**
          * @brief Finds all possible solutions to the 8-queens problem.
          * 
+         * @param engine A const reference to the QueenEngine used for the search. BITMASK by default.
          * @return A vector of CharacterBoard objects, 
          *         each representing a unique solution 
          *         to the 8-queens problem.
         */
-        static std::vector<CharacterBoard> findAllQueenPlacements();
+        static std::vector<CharacterBoard> findAllQueenPlacements(const QueenEngine& engine = QueenEngine::BITMASK);
+
+        /**
+         * @brief Finds all possible solutions to the n-queens problem.
+         * @note The PIECES engine is limited to boards of at most BOARD_LENGTH, larger boards are always solved with BITMASK.
+         * 
+         * @param n A const reference to an integer representing the number of rows & columns of the board, in [1, MAX_QUEENS_LENGTH]
+         * @param engine A const reference to the QueenEngine used for the search. BITMASK by default.
+         * @param threads A const reference to the number of worker threads used by the PARALLEL engine. If not positive, the hardware concurrency is used.
+         * @return A vector of n x n CharacterBoard objects, each representing a solution to the n-queens problem.
+         *         Empty if n is out of range.
+        */
+        static std::vector<CharacterBoard> findAllQueenPlacements(const int& n, const QueenEngine& engine = QueenEngine::BITMASK, const int& threads = 0);
+
+        /**
+         * @brief Finds all possible solutions to the n-queens problem, in their compact form.
+         * @note The PIECES engine builds CharacterBoards, which are converted back to QueenPlacements.
+         * 
+         * @param n A const reference to an integer representing the number of rows & columns of the board, in [1, MAX_QUEENS_LENGTH]
+         * @param engine A const reference to the QueenEngine used for the search. BITMASK by default.
+         * @param threads A const reference to the number of worker threads used by the PARALLEL engine. If not positive, the hardware concurrency is used.
+         * @return A vector of QueenPlacement objects, each representing a solution to the n-queens problem.
+         *         Empty if n is out of range.
+        */
+        static std::vector<QueenPlacement> findAllQueenSolutions(const int& n, const QueenEngine& engine = QueenEngine::BITMASK, const int& threads = 0);
+
+        /**
+         * @brief Counts the solutions to the n-queens problem without building any boards.
+         * @note The PIECES engine has no counting-only search, so it counts the boards found by findAllQueenPlacements.
+         * 
+         * @param n A const reference to an integer representing the number of rows & columns of the board, in [1, MAX_QUEENS_LENGTH]
+         * @param engine A const reference to the QueenEngine used for the search. BITMASK by default.
+         * @param threads A const reference to the number of worker threads used by the PARALLEL engine. If not positive, the hardware concurrency is used.
+         * @return The number of solutions to the n-queens problem. 0 if n is out of range.
+        */
+        static uint64_t countQueenPlacements(const int& n, const QueenEngine& engine = QueenEngine::BITMASK, const int& threads = 0);
+
+        /**
+         * @brief Streams the solutions to the n-queens problem to a visitor as soon as they are found.
+         * 
+         * Solutions arrive in the order of the sequential search, and only the placement being built is kept in memory, 
+         * no matter how many solutions exist. The visitor can stop the search early by returning false, 
+         * for example once it has received the first k solutions.
+         * 
+         * @param n A const reference to an integer representing the number of rows & columns of the board, in [1, MAX_QUEENS_LENGTH]
+         * @param visitor A const reference to a function receiving each solution, returning false to stop the search
+         * @return The number of solutions handed to the visitor. 0 if n is out of range.
+        */
+        static uint64_t visitQueenSolutions(const int& n, const QueenVisitor& visitor);
+
+        /**
+         * @brief Finds one solution to the n-queens problem per group of solutions that are rotations / flips of each other.
+         * 
+         * Only the fundamental domain is searched, and no orbit is expanded. The solution kept for each group is the 
+         * one the sequential search finds first.
+         * 
+         * @param n A const reference to an integer representing the number of rows & columns of the board, in [1, MAX_QUEENS_LENGTH]
+         * @return A vector of n x n CharacterBoard objects, in the order the sequential search finds them. Empty if n is out of range.
+         */
+        static std::vector<CharacterBoard> findUniqueQueenPlacements(const int& n);
+
+        /**
+         * @brief Finds one solution to the n-queens problem per group of solutions that are rotations / flips of each other, in their compact form.
+         * 
+         * @param n A const reference to an integer representing the number of rows & columns of the board, in [1, MAX_QUEENS_LENGTH]
+         * @return A vector of QueenPlacement objects, in the order the sequential search finds them. Empty if n is out of range.
+         */
+        static std::vector<QueenPlacement> findUniqueQueenSolutions(const int& n);
+
+        /**
+         * @brief Expands a board into every distinct board reachable by a
+         *      1) Rotation (clockwise: 0°, 90°, 180°, 270°)
+         *      2) Optionally followed by a flip across the vertical axis
+         * 
+         * @param board A const reference to a CharacterBoard holding one queen per row & column
+         * @return A vector of the distinct transformed boards (including `board` itself), in the order the queen searches find them
+         */
+        static std::vector<CharacterBoard> expandQueenOrbit(const CharacterBoard& board);
+
+        /**
+         * @brief Expands a solution into every distinct solution reachable by a rotation, optionally followed by a flip across the vertical axis
+         * 
+         * @param placement A const reference to a QueenPlacement holding one queen per row
+         * @return A vector of the distinct transformed placements (including `placement` itself), in the order the queen searches find them
+         */
+        static std::vector<QueenPlacement> expandQueenOrbit(const QueenPlacement& placement);
 
         /**
          * @brief Groups similar chessboard configurations by transformations.
@@ -122,6 +679,16 @@ class ChessBoard {
          */
         static std::vector<std::vector<CharacterBoard>> groupSimilarBoards(const std::vector<CharacterBoard>& boards);
 
-
+        /**
+         * @brief Groups similar n-queens solutions by transformations, in their compact form.
+         * 
+         * Solutions are similar if one is a rotation of the other, optionally followed by a flip. 
+         * Each solution is keyed by the smallest placement of its orbit, so grouping is linear in the number of solutions.
+         * 
+         * @param placements A const reference to a vector of QueenPlacement objects, each holding one queen per row
+         * @return A 2D vector of QueenPlacement objects, where each inner vector is a list of placements 
+         *         that are transformations of each other. Groups and their members keep the order of `placements`.
+         */
+        static std::vector<std::vector<QueenPlacement>> groupSimilarPlacements(const std::vector<QueenPlacement>& placements);
 
 };
\ No newline at end of file
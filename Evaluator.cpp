@@ -0,0 +1,127 @@
+#include "Evaluator.hpp"
+
+namespace {
+    // Pawn structure terms, in centipawns
+    constexpr PieceSquare::Score DOUBLED_PAWN = {-10, -20};       // Per pawn behind another of its color on its column
+    constexpr PieceSquare::Score ISOLATED_PAWN = {-10, -15};      // Per pawn without a pawn of its color on a neighboring column
+
+    // Per passed pawn (no enemy pawn ahead of it on its own or a neighboring column), by the rows it has advanced
+    constexpr PieceSquare::Score PASSED_PAWN[8] = {{0, 0}, {5, 10}, {10, 20}, {20, 40}, {35, 70}, {60, 120}, {100, 200}, {0, 0}};
+
+    constexpr Attacks::Mask FIRST_COLUMN = 0x0101010101010101ULL;
+
+    /**
+     * @brief Gets the squares of a column
+     */
+    constexpr Attacks::Mask columnMask(const int& col) {
+        return FIRST_COLUMN << col;
+    }
+
+    /**
+     * @brief Gets the squares of a column & of its neighbors
+     */
+    constexpr Attacks::Mask adjacentColumnsMask(const int& col) {
+        return (col > 0 ? columnMask(col - 1) : 0) | (col < 7 ? columnMask(col + 1) : 0);
+    }
+};
+
+/**
+ * @brief Constructs an evaluator
+ * @param pawnCacheKilobytes A const reference to the size of the pawn structure cache in KB, 0 to evaluate the pawns at every call.
+ *      The largest power of 2 of entries that fits is used.
+ */
+Evaluator::Evaluator(const size_t& pawnCacheKilobytes) : pawnCache_{} {
+    if (pawnCacheKilobytes == 0) { return; }
+
+    size_t entries = 1;
+    while ((entries * 2) * sizeof(PawnEntry) <= (pawnCacheKilobytes << 10)) { entries *= 2; }
+
+    // Zeroed entries hold the empty pawn structure (pawn hash 0), which scores 0: no entry needs an "empty" marker
+    pawnCache_.assign(entries, PawnEntry{0, PieceSquare::Score{0, 0}});
+}
+
+/**
+ * @brief Constructs an evaluator with a pawn structure cache of DEFAULT_PAWN_CACHE_KILOBYTES
+ */
+Evaluator::Evaluator() : Evaluator(DEFAULT_PAWN_CACHE_KILOBYTES) {}
+
+/**
+ * @brief Evaluates a position
+ * @param board A const reference to the position
+ * @return The score of the side to move, in centipawns: material, piece-square & pawn structure, blended by the game phase
+ */
+int Evaluator::evaluate(const ChessBoard& board) {
+    PieceSquare::Score pawns;
+    if (pawnCache_.empty()) {
+        pawns = pawnStructure(board);
+    } else {
+        const Zobrist::Key key = board.getPawnHash();
+        PawnEntry& entry = pawnCache_[key & (pawnCache_.size() - 1)];
+        if (entry.key != key) {
+            entry.key = key;
+            entry.score = pawnStructure(board);
+        }
+        pawns = entry.score;
+    }
+
+    const int us = board.sideToMove();
+    PieceSquare::Score score = board.getPieceSquareScore(us) - board.getPieceSquareScore(us ^ 1);
+    if (us == ChessPiece::WHITE) { score += pawns; }
+    else { score -= pawns; }
+
+    return PieceSquare::taper(score, board.getGamePhase());
+}
+
+/**
+ * @brief Scores the pawn structure of a position, without the cache
+ * @param board A const reference to the position
+ * @return The pawn structure terms of WHITE minus those of BLACK
+ */
+PieceSquare::Score Evaluator::pawnStructure(const ChessBoard& board) {
+    const Attacks::Mask white = board.getPieces(ChessPiece::WHITE, PieceType::PAWN);
+    const Attacks::Mask black = board.getPieces(ChessPiece::BLACK, PieceType::PAWN);
+
+    return pawnsOf(white, black, ChessPiece::WHITE) - pawnsOf(black, white, ChessPiece::BLACK);
+}
+
+/**
+ * @brief Scores the pawns of one player
+ * @param own A const reference to the squares of the player's pawns
+ * @param enemy A const reference to the squares of the opponent's pawns
+ * @param color A const reference to the color of the player
+ * @return The doubled, isolated & passed pawn terms of the player, for its own side
+ */
+PieceSquare::Score Evaluator::pawnsOf(const Attacks::Mask& own, const Attacks::Mask& enemy, const int& color) {
+    PieceSquare::Score score{0, 0};
+
+    for (int col = 0; col < 8; col++) {
+        int count = __builtin_popcountll(own & columnMask(col));
+        if (count == 0) { continue; }
+
+        for (int extra = 1; extra < count; extra++) { score += DOUBLED_PAWN; }
+        if (!(own & adjacentColumnsMask(col))) {
+            for (int pawn = 0; pawn < count; pawn++) { score += ISOLATED_PAWN; }
+        }
+    }
+
+    for (Attacks::Mask pawns = own; pawns; pawns &= pawns - 1) {
+        const int square = __builtin_ctzll(pawns);
+        const int row = square / 8;
+        const int col = square % 8;
+
+        // BLACK pawns move up the rows, WHITE pawns down
+        Attacks::Mask ahead;
+        int advanced;
+        if (color == ChessPiece::BLACK) {
+            ahead = row < 7 ? ~0ULL << ((row + 1) * 8) : 0;
+            advanced = row;
+        } else {
+            ahead = (1ULL << (row * 8)) - 1;
+            advanced = 7 - row;
+        }
+
+        if (!(enemy & ahead & (columnMask(col) | adjacentColumnsMask(col)))) { score += PASSED_PAWN[advanced]; }
+    }
+
+    return score;
+}
@@ -0,0 +1,72 @@
+/**
+ * @class Evaluator
+ * @brief Scores a position statically, for the leaves of the search.
+ *
+ * The material & piece-square terms are read from the running sums ChessBoard keeps up to date as moves are made
+ * and taken back, so they cost nothing at a leaf. The pawn structure (doubled, isolated & passed pawns) only changes
+ * when pawns move or are captured, so its score is cached by the pawn hash of the board: a pawn configuration met
+ * again anywhere in the tree is looked up instead of evaluated.
+ *
+ * An Evaluator is not thread safe: each searching thread owns one.
+ */
+
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include "ChessBoard.hpp"
+#include "PieceSquare.hpp"
+
+class Evaluator {
+    public:
+        // The size of the pawn structure cache the search gives each thread
+        static constexpr size_t DEFAULT_PAWN_CACHE_KILOBYTES = 256;
+
+    private:
+        /**
+         * @brief A cached pawn structure score
+         */
+        struct PawnEntry {
+            Zobrist::Key key;
+            PieceSquare::Score score;
+        };
+
+        // A power of 2 of entries, indexed by the low bits of the pawn hash. Empty when the cache is off.
+        std::vector<PawnEntry> pawnCache_;
+
+        /**
+         * @brief Scores the pawns of one player
+         * @param own A const reference to the squares of the player's pawns
+         * @param enemy A const reference to the squares of the opponent's pawns
+         * @param color A const reference to the color of the player
+         * @return The doubled, isolated & passed pawn terms of the player, for its own side
+         */
+        static PieceSquare::Score pawnsOf(const Attacks::Mask& own, const Attacks::Mask& enemy, const int& color);
+
+    public:
+        /**
+         * @brief Constructs an evaluator
+         * @param pawnCacheKilobytes A const reference to the size of the pawn structure cache in KB, 0 to evaluate the pawns at every call.
+         *      The largest power of 2 of entries that fits is used.
+         */
+        explicit Evaluator(const size_t& pawnCacheKilobytes);
+
+        /**
+         * @brief Constructs an evaluator with a pawn structure cache of DEFAULT_PAWN_CACHE_KILOBYTES
+         */
+        Evaluator();
+
+        /**
+         * @brief Evaluates a position
+         * @param board A const reference to the position
+         * @return The score of the side to move, in centipawns: material, piece-square & pawn structure, blended by the game phase
+         */
+        int evaluate(const ChessBoard& board);
+
+        /**
+         * @brief Scores the pawn structure of a position, without the cache
+         * @param board A const reference to the position
+         * @return The pawn structure terms of WHITE minus those of BLACK
+         */
+        static PieceSquare::Score pawnStructure(const ChessBoard& board);
+};
@@ -0,0 +1,126 @@
+#include "Mailbox.hpp"
+#include "pieces_module.hpp"
+#include <algorithm>
+#include <cstring>
+
+/**
+ * @brief Default constructor.
+ * @post Every square is EMPTY.
+ */
+Mailbox::Mailbox() : squares_{} {}
+
+/**
+ * @brief Builds the standard starting position (see ChessBoard::ChessBoard())
+ * @return A Mailbox with black on rows 0 & 1 (its pawns moving up), white on rows 6 & 7, and every Rook able to castle 3 times
+ */
+Mailbox Mailbox::standard() {
+    static const std::array<Type, LENGTH> inner_pieces = {ROOK, KNIGHT, BISHOP, KING, QUEEN, BISHOP, KNIGHT, ROOK};
+
+    Mailbox mailbox;
+    for (int i = 0; i < LENGTH; i++) {
+        mailbox.set(square(0, i), makePiece(inner_pieces[i], false));
+        mailbox.set(square(1, i), makePiece(PAWN, false, true));
+        mailbox.set(square(6, i), makePiece(PAWN, true));
+        mailbox.set(square(7, i), makePiece(inner_pieces[i], true));
+    }
+
+    return mailbox;
+}
+
+/**
+ * @brief Gets the occupied squares, so a Mailbox can be read by MoveRules
+ * @return A mask with bit (row * LENGTH + col) set for every non-empty square
+ */
+Attacks::Mask Mailbox::occupancy() const {
+    const uint64_t low_bits = 0x7F7F7F7F7F7F7F7Full;
+
+    Attacks::Mask occupied = 0;
+    for (int row = 0; row < LENGTH; row++) {
+        // Read a row as 8 bytes at once, and set the top bit of each non-empty byte
+        uint64_t cells;
+        std::memcpy(&cells, &squares_[row * LENGTH], sizeof(cells));
+        uint64_t filled = (((cells & low_bits) + low_bits) | cells) & ~low_bits;
+
+        // Gather the 8 top bits into one byte (bit i for the byte of column i)
+        occupied |= (((filled >> 7) * 0x0102040810204080ull) >> 56) << (row * LENGTH);
+    }
+
+    return occupied;
+}
+
+/**
+ * @brief Gets the squares held by pieces of one color, so a Mailbox can be read by MoveRules
+ * @param color A const reference to ChessPiece::WHITE or ChessPiece::BLACK
+ * @return A mask with bit (row * LENGTH + col) set for every square holding a piece of `color` (empty for any other color)
+ */
+Attacks::Mask Mailbox::occupancyOf(const ChessPiece::Color& color) const {
+    if (color != ChessPiece::WHITE && color != ChessPiece::BLACK) { return 0; }
+
+    // Move the WHITE flag of each byte to its top bit, then gather the 8 top bits as in occupancy()
+    Attacks::Mask white = 0;
+    for (int row = 0; row < LENGTH; row++) {
+        uint64_t cells;
+        std::memcpy(&cells, &squares_[row * LENGTH], sizeof(cells));
+        uint64_t flags = (cells << 4) & 0x8080808080808080ull;
+
+        white |= (((flags >> 7) * 0x0102040810204080ull) >> 56) << (row * LENGTH);
+    }
+
+    return color == ChessPiece::WHITE ? white : occupancy() & ~white;
+}
+
+/**
+ * @brief Encodes a ChessPiece
+ *
+ * @param piece A const reference to a ChessPiece
+ * @param whiteColor A const reference to the color of the white pieces. Pieces of any other color are encoded as black.
+ * @return The Piece code of `piece`, EMPTY if its type is not one of the 6 chess pieces
+ */
+Mailbox::Piece Mailbox::encode(const ChessPiece& piece, const std::string& whiteColor) {
+    static_assert(static_cast<int>(PieceType::KING) == KING, "Mailbox::Type mirrors PieceType");
+
+    Type type = static_cast<Type>(piece.getPieceType());
+    if (type == NONE) { return EMPTY; }
+
+    const Rook* rook = dynamic_cast<const Rook*>(&piece);
+    int castleMoves = rook ? rook->getCastleMovesLeft() : MAX_CASTLE_MOVES;
+
+    return makePiece(type, piece.getColor() == whiteColor, piece.isMovingUp(), castleMoves, piece.hasMoved());
+}
+
+/**
+ * @brief Builds the ChessPiece described by a piece code
+ *
+ * @param piece A const reference to a Piece code
+ * @param row A const reference to the row of the piece
+ * @param col A const reference to the column of the piece
+ * @param blackColor A const reference to the color given to black pieces
+ * @param whiteColor A const reference to the color given to white pieces
+ * @return A pointer to a newly allocated ChessPiece (owned by the caller), nullptr if `piece` is EMPTY
+ */
+ChessPiece* Mailbox::decode(const Piece& piece, const int& row, const int& col, const std::string& blackColor, const std::string& whiteColor) {
+    const std::string& color = isWhite(piece) ? whiteColor : blackColor;
+    bool movingUp = isMovingUp(piece);
+
+    ChessPiece* decoded = nullptr;
+    switch (typeOf(piece)) {
+        case PAWN:   decoded = new Pawn(color, row, col, movingUp); break;
+        case KNIGHT: decoded = new Knight(color, row, col, movingUp); break;
+        case BISHOP: decoded = new Bishop(color, row, col, movingUp); break;
+        case ROOK:   decoded = new Rook(color, row, col, movingUp, castleMovesOf(piece)); break;
+        case QUEEN:  decoded = new Queen(color, row, col, movingUp); break;
+        case KING:   decoded = new King(color, row, col, movingUp); break;
+        default:     return nullptr;
+    }
+
+    if (hasMoved(piece)) { decoded->flagMoved(); }
+    return decoded;
+}
+
+bool Mailbox::operator==(const Mailbox& other) const {
+    return squares_ == other.squares_;
+}
+
+bool Mailbox::operator!=(const Mailbox& other) const {
+    return squares_ != other.squares_;
+}
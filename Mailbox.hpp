@@ -0,0 +1,180 @@
+/**
+ * @class Mailbox
+ * @brief A flat 8x8 board holding a 1-byte piece code per square.
+ *
+ * Squares are stored contiguously in row-major order (square = row * 8 + col), so the
+ * whole board is 64 bytes: one cache line. Copying, constructing and scanning a Mailbox
+ * never allocates. ChessPiece objects are only built on request (see decode).
+ *
+ * A piece code packs, from the lowest bit:
+ *      bits 0-2  The piece type (see Type). NONE marks an empty square.
+ *      bit  3    WHITE: set for white pieces, clear for black pieces
+ *      bit  4    MOVED: the piece has moved (ChessPiece::hasMoved)
+ *      bit  5    MOVING_UP: the piece moves up the board (ChessPiece::isMovingUp)
+ *      bits 6-7  The castle moves a Rook has left (Rook::getCastleMovesLeft, at most 3)
+ */
+
+#pragma once
+
+#include <array>
+#include <string>
+#include <cstdint>
+#include "pieces/ChessPiece.hpp"
+#include "pieces/Attacks.hpp"
+
+class Mailbox {
+    public:
+        // The number of rows & columns of the board
+        static constexpr int LENGTH = 8;
+
+        // The number of squares of the board
+        static constexpr int SQUARES = LENGTH * LENGTH;
+
+        // Alias for readability
+        typedef uint8_t Piece;
+
+        // The piece types, as stored in the lowest 3 bits of a Piece
+        enum Type : uint8_t { NONE, PAWN, KNIGHT, BISHOP, ROOK, QUEEN, KING };
+
+        // The flags stored above the type of a Piece
+        static constexpr Piece TYPE_MASK = 0x07;
+        static constexpr Piece WHITE = 0x08;
+        static constexpr Piece MOVED = 0x10;
+        static constexpr Piece MOVING_UP = 0x20;
+        static constexpr int CASTLE_SHIFT = 6;
+        static constexpr int MAX_CASTLE_MOVES = 3;
+
+        // The code of an empty square
+        static constexpr Piece EMPTY = NONE;
+
+    private:
+        alignas(64) std::array<Piece, SQUARES> squares_;  // squares_[row * LENGTH + col] is the piece on (row, col)
+
+    public:
+        /**
+         * @brief Default constructor.
+         * @post Every square is EMPTY.
+         */
+        Mailbox();
+
+        /**
+         * @brief Builds the standard starting position (see ChessBoard::ChessBoard())
+         * @return A Mailbox with black on rows 0 & 1 (its pawns moving up), white on rows 6 & 7, and every Rook able to castle 3 times
+         */
+        static Mailbox standard();
+
+        /**
+         * @brief Gets the index of a square
+         * @return The index of (row, col) in row-major order
+         */
+        static constexpr int square(const int& row, const int& col) { return row * LENGTH + col; }
+
+        /**
+         * @brief Builds a piece code
+         *
+         * @param type A const reference to the Type of the piece
+         * @param white A const reference to a boolean, true if the piece is white
+         * @param movingUp A const reference to a boolean, true if the piece moves up the board
+         * @param castleMoves A const reference to the castle moves left (only kept for Rooks). Clamped to [0, MAX_CASTLE_MOVES].
+         * @param moved A const reference to a boolean, true if the piece has moved
+         * @return The Piece code
+         */
+        static constexpr Piece makePiece(const Type& type, const bool& white, const bool& movingUp = false, const int& castleMoves = MAX_CASTLE_MOVES, const bool& moved = false) {
+            if (type == NONE) { return EMPTY; }
+
+            Piece piece = static_cast<Piece>(type | (white ? WHITE : 0) | (moved ? MOVED : 0) | (movingUp ? MOVING_UP : 0));
+            if (type == ROOK) { piece |= (castleMoves < 0 ? 0 : (castleMoves > MAX_CASTLE_MOVES ? MAX_CASTLE_MOVES : castleMoves)) << CASTLE_SHIFT; }
+
+            return piece;
+        }
+
+        // Reads the fields of a piece code
+        static constexpr Type typeOf(const Piece& piece) { return static_cast<Type>(piece & TYPE_MASK); }
+        static constexpr bool isWhite(const Piece& piece) { return piece & WHITE; }
+        static constexpr bool hasMoved(const Piece& piece) { return piece & MOVED; }
+        static constexpr bool isMovingUp(const Piece& piece) { return piece & MOVING_UP; }
+        static constexpr int castleMovesOf(const Piece& piece) { return piece >> CASTLE_SHIFT; }
+
+        /**
+         * @brief Gets the piece on a square
+         * @param row A const reference to a row in [0, LENGTH)
+         * @param col A const reference to a column in [0, LENGTH)
+         * @return The Piece code on (row, col), EMPTY if there is none
+         */
+        Piece at(const int& row, const int& col) const { return squares_[square(row, col)]; }
+
+        /**
+         * @brief Gets the piece on a square
+         * @param square A const reference to a square index in [0, SQUARES)
+         * @return The Piece code on the square, EMPTY if there is none
+         */
+        Piece operator[](const int& square) const { return squares_[square]; }
+
+        /**
+         * @brief Gets the number of rows & columns, so a Mailbox can be read by MoveRules
+         */
+        int length() const { return LENGTH; }
+
+        /**
+         * @brief Gets the color of the piece on a square, so a Mailbox can be read by MoveRules
+         * @param row A const reference to a row in [0, LENGTH)
+         * @param col A const reference to a column in [0, LENGTH)
+         * @return ChessPiece::WHITE or ChessPiece::BLACK, or MoveRules::EMPTY (-1) if the square is empty
+         */
+        int colorAt(const int& row, const int& col) const {
+            Piece piece = squares_[square(row, col)];
+            if (piece == EMPTY) { return -1; }
+            return isWhite(piece) ? ChessPiece::WHITE : ChessPiece::BLACK;
+        }
+
+        /**
+         * @brief Gets the occupied squares, so a Mailbox can be read by MoveRules
+         * @return A mask with bit (row * LENGTH + col) set for every non-empty square
+         */
+        Attacks::Mask occupancy() const;
+
+        /**
+         * @brief Determines whether a set of squares is empty, so a Mailbox can be read by MoveRules
+         * @param squares A const reference to a mask of squares
+         * @return True if no piece stands on any of `squares`
+         */
+        bool isClear(const Attacks::Mask& squares) const { return (occupancy() & squares) == 0; }
+
+        /**
+         * @brief Gets the squares held by pieces of one color, so a Mailbox can be read by MoveRules
+         * @param color A const reference to ChessPiece::WHITE or ChessPiece::BLACK
+         * @return A mask with bit (row * LENGTH + col) set for every square holding a piece of `color` (empty for any other color)
+         */
+        Attacks::Mask occupancyOf(const ChessPiece::Color& color) const;
+
+        /**
+         * @brief Sets the piece on a square
+         * @param square A const reference to a square index in [0, SQUARES)
+         * @param piece A const reference to the Piece code to store (EMPTY to clear the square)
+         */
+        void set(const int& square, const Piece& piece) { squares_[square] = piece; }
+
+        /**
+         * @brief Encodes a ChessPiece
+         *
+         * @param piece A const reference to a ChessPiece
+         * @param whiteColor A const reference to the color of the white pieces. Pieces of any other color are encoded as black.
+         * @return The Piece code of `piece`, EMPTY if its type is not one of the 6 chess pieces
+         */
+        static Piece encode(const ChessPiece& piece, const std::string& whiteColor);
+
+        /**
+         * @brief Builds the ChessPiece described by a piece code
+         *
+         * @param piece A const reference to a Piece code
+         * @param row A const reference to the row of the piece
+         * @param col A const reference to the column of the piece
+         * @param blackColor A const reference to the color given to black pieces
+         * @param whiteColor A const reference to the color given to white pieces
+         * @return A pointer to a newly allocated ChessPiece (owned by the caller), nullptr if `piece` is EMPTY
+         */
+        static ChessPiece* decode(const Piece& piece, const int& row, const int& col, const std::string& blackColor, const std::string& whiteColor);
+
+        bool operator==(const Mailbox& other) const;
+        bool operator!=(const Mailbox& other) const;
+};
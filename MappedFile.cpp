@@ -0,0 +1,74 @@
+#include "MappedFile.hpp"
+#include <fstream>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+/**
+ * @brief Maps a file
+ * @param path A const reference to the path of the file
+ * @param sequential A const reference to a boolean, true if the file will be read from start to end (the OS then reads ahead)
+ * @post isOpen() is true if the file was mapped
+ */
+MappedFile::MappedFile(const std::string& path, const bool& sequential) : data_{nullptr}, size_{0}, open_{false}, mapped_{false}, fallback_{} {
+#ifdef __linux__
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) { return; }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        return;
+    }
+
+    // An empty file cannot be mapped, but is open all the same
+    if (info.st_size > 0) {
+        // The mapping keeps the file alive once the descriptor is closed
+        void* memory = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (memory == MAP_FAILED) { return; }
+#ifdef MADV_SEQUENTIAL
+        if (sequential) { madvise(memory, info.st_size, MADV_SEQUENTIAL); }
+#endif
+        data_ = static_cast<const char*>(memory);
+        size_ = info.st_size;
+        mapped_ = true;
+    } else {
+        ::close(fd);
+    }
+
+    open_ = true;
+#else
+    (void) sequential;
+
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) { return; }
+
+    const std::streamoff bytes = in.tellg();
+    if (bytes < 0) { return; }
+
+    fallback_.resize(bytes);
+    in.seekg(0);
+    if (!in.read(fallback_.data(), bytes)) {
+        fallback_.clear();
+        return;
+    }
+
+    data_ = fallback_.empty() ? nullptr : fallback_.data();
+    size_ = fallback_.size();
+    open_ = true;
+#endif
+}
+
+/**
+ * @brief Destructor. Unmaps the file.
+ */
+MappedFile::~MappedFile() {
+#ifdef __linux__
+    if (mapped_) { munmap(const_cast<char*>(data_), size_); }
+#endif
+}
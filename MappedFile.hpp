@@ -0,0 +1,61 @@
+/**
+ * @class MappedFile
+ * @brief A whole file mapped read-only into memory.
+ *
+ * The bytes are read in place: the OS loads the pages as they are first touched and may drop them again
+ * under memory pressure (they are clean), so a file far larger than the memory can be scanned with a flat
+ * footprint. Where memory mapping is unavailable, the file is read into a buffer instead.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <string_view>
+
+class MappedFile {
+    private:
+        const char* data_;
+        size_t size_;
+        bool open_;
+        bool mapped_;                   // False if the bytes are held in `fallback_` instead of a mapping
+        std::vector<char> fallback_;    // Used where memory mapping is unavailable
+
+    public:
+        /**
+         * @brief Maps a file
+         * @param path A const reference to the path of the file
+         * @param sequential A const reference to a boolean, true if the file will be read from start to end (the OS then reads ahead)
+         * @post isOpen() is true if the file was mapped
+         */
+        MappedFile(const std::string& path, const bool& sequential);
+
+        /**
+         * @brief Destructor. Unmaps the file.
+         */
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /**
+         * @brief Determines whether the file was opened
+         */
+        bool isOpen() const { return open_; }
+
+        /**
+         * @brief Gets the first byte of the file (nullptr if it is empty or not open)
+         */
+        const char* data() const { return data_; }
+
+        /**
+         * @brief Gets the size of the file in bytes (0 if it is not open)
+         */
+        size_t size() const { return size_; }
+
+        /**
+         * @brief Gets the bytes of the file, in place
+         */
+        std::string_view view() const { return std::string_view(data_, size_); }
+};
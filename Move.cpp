@@ -0,0 +1,25 @@
+#include "Move.hpp"
+
+/**
+ * @brief Writes the move in long algebraic (UCI) notation, such as "e2e4" or "a7a8q"
+ * @note Files & ranks are read the way FEN reads the board: row r is rank 8 - r and column c is file 'h' - c,
+ *      so the white king of ChessBoard() starts on e1.
+ * @return The UCI string of the move
+ */
+std::string Move::toString() const {
+    std::string text;
+    for (const int& square : {from(), to()}) {
+        text += static_cast<char>('h' - square % 8);
+        text += static_cast<char>('8' - square / 8);
+    }
+
+    switch (promotionType()) {
+        case PieceType::KNIGHT: text += 'n'; break;
+        case PieceType::BISHOP: text += 'b'; break;
+        case PieceType::ROOK:   text += 'r'; break;
+        case PieceType::QUEEN:  text += 'q'; break;
+        default:                break;
+    }
+
+    return text;
+}
@@ -0,0 +1,153 @@
+/**
+ * @class Move
+ * @brief A chess move packed into 16 bits: its from square, its to square and 4 flag bits.
+ *
+ * Squares use the Mailbox order (square = row * 8 + col). From the lowest bit:
+ *      bits 0-5    The square the piece moves from
+ *      bits 6-11   The square the piece moves to
+ *      bits 12-15  The Flag of the move. PROMOTION is set for promotions, with the promoted-to piece in the 2 lowest flag bits.
+ *
+ * Castling is stored as the move of the king. "King side" castling is towards column 0, where the king starts next to its rook.
+ */
+
+#pragma once
+
+#include <array>
+#include <string>
+#include <cstdint>
+#include "pieces/ChessPiece.hpp"
+
+class Move {
+    public:
+        // The kind of a move, as stored in its 4 highest bits
+        enum Flag : uint8_t {
+            QUIET = 0,
+            DOUBLE_PUSH = 1,
+            KING_CASTLE = 2,
+            QUEEN_CASTLE = 3,
+            CAPTURE = 4,
+            EN_PASSANT = 5,
+            PROMOTION = 8,                  // | (promoted-to type - KNIGHT)
+            PROMOTION_CAPTURE = 12          // | (promoted-to type - KNIGHT)
+        };
+
+    private:
+        uint16_t data_;
+
+    public:
+        /**
+         * @brief Default constructor. The move is left unset, so a MoveList can hold a buffer of moves without clearing it.
+         */
+        Move() = default;
+
+        /**
+         * @brief Builds a move
+         * @param from A const reference to the square the piece moves from, in [0, 64)
+         * @param to A const reference to the square the piece moves to, in [0, 64)
+         * @param flags A const reference to the Flag of the move (with the promoted-to piece, for promotions)
+         */
+        constexpr Move(const int& from, const int& to, const int& flags = QUIET) : data_(static_cast<uint16_t>(from | (to << 6) | (flags << 12))) {}
+
+        /**
+         * @brief Builds a promotion
+         * @param from A const reference to the square the pawn moves from
+         * @param to A const reference to the square the pawn moves to
+         * @param promotion A const reference to the type the pawn is promoted to: KNIGHT, BISHOP, ROOK or QUEEN
+         * @param capture A const reference to a boolean, true if the pawn captures a piece on `to`
+         * @return The promotion Move
+         */
+        static constexpr Move promotion(const int& from, const int& to, const PieceType& promotion, const bool& capture) {
+            return Move(from, to, (capture ? PROMOTION_CAPTURE : PROMOTION) | (static_cast<int>(promotion) - static_cast<int>(PieceType::KNIGHT)));
+        }
+
+        // The null move (from & to are both square 0), never produced by the move generator
+        static constexpr Move none() { return Move(0, 0); }
+
+        // Reads the fields of a move
+        constexpr int from() const { return data_ & 0x3F; }
+        constexpr int to() const { return (data_ >> 6) & 0x3F; }
+        constexpr int flags() const { return data_ >> 12; }
+        constexpr uint16_t raw() const { return data_; }
+
+        constexpr bool isCapture() const { return data_ & (CAPTURE << 12); }
+        constexpr bool isPromotion() const { return data_ & (PROMOTION << 12); }
+        constexpr bool isEnPassant() const { return flags() == EN_PASSANT; }
+        constexpr bool isDoublePush() const { return flags() == DOUBLE_PUSH; }
+        constexpr bool isCastle() const { return flags() == KING_CASTLE || flags() == QUEEN_CASTLE; }
+
+        /**
+         * @brief Gets the type a promotion produces
+         * @return KNIGHT, BISHOP, ROOK or QUEEN for a promotion. PieceType::NONE otherwise.
+         */
+        constexpr PieceType promotionType() const {
+            return isPromotion() ? static_cast<PieceType>(static_cast<int>(PieceType::KNIGHT) + (flags() & 0x3)) : PieceType::NONE;
+        }
+
+        constexpr bool operator==(const Move& other) const { return data_ == other.data_; }
+        constexpr bool operator!=(const Move& other) const { return data_ != other.data_; }
+
+        /**
+         * @brief Writes the move in long algebraic (UCI) notation, such as "e2e4" or "a7a8q"
+         * @note Files & ranks are read the way FEN reads the board: row r is rank 8 - r and column c is file 'h' - c,
+         *      so the white king of ChessBoard() starts on e1.
+         * @return The UCI string of the move
+         */
+        std::string toString() const;
+};
+
+/**
+ * @class MoveList
+ * @brief A fixed-capacity buffer of moves, meant to live on the stack of the caller of the move generator.
+ */
+class MoveList {
+    public:
+        // More than the 218 legal moves of the richest known chess position
+        static constexpr int CAPACITY = 256;
+
+    private:
+        std::array<Move, CAPACITY> moves_;
+        int size_;
+
+    public:
+        /**
+         * @brief Default constructor.
+         * @post The list is empty (its buffer is left uninitialized).
+         */
+        MoveList() : size_{0} {}
+
+        /**
+         * @brief Appends a move
+         * @pre The list holds fewer than CAPACITY moves
+         * @param move A const reference to the Move to append
+         */
+        void push(const Move& move) { moves_[size_++] = move; }
+
+        /**
+         * @brief Removes every move
+         */
+        void clear() { size_ = 0; }
+
+        int size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+
+        Move& operator[](const int& index) { return moves_[index]; }
+        const Move& operator[](const int& index) const { return moves_[index]; }
+
+        Move* begin() { return moves_.data(); }
+        Move* end() { return moves_.data() + size_; }
+        const Move* begin() const { return moves_.data(); }
+        const Move* end() const { return moves_.data() + size_; }
+
+        /**
+         * @brief Checks whether the list holds a move
+         * @param move A const reference to a Move
+         * @return True if `move` is in the list. False otherwise.
+         */
+        bool contains(const Move& move) const {
+            for (const Move& listed : *this) {
+                if (listed == move) { return true; }
+            }
+
+            return false;
+        }
+};
@@ -0,0 +1,45 @@
+#include "PackedPosition.hpp"
+#include <fstream>
+
+/**
+ * @brief Reads the piece on a square, without unpacking the position
+ * @param square A const reference to a square (row * 8 + col)
+ * @return The type & color bits of the piece (Mailbox::typeOf & Mailbox::isWhite read them), Mailbox::EMPTY if there is none
+ */
+Mailbox::Piece PackedPosition::pieceAt(const int& square) const {
+    const uint64_t bit = 1ULL << square;
+    if (!(occupancy & bit)) { return Mailbox::EMPTY; }
+
+    // The pieces are stored in square order, so the index of this one is the number of occupied squares below it
+    const int index = __builtin_popcountll(occupancy & (bit - 1));
+    return (pieces[index / 2] >> (4 * (index % 2))) & 0x0F;
+}
+
+/**
+ * @brief Maps a file of PackedPosition records
+ * @param path A const reference to the path of the file
+ * @post isOpen() is true if the file was mapped. A file whose size is not a multiple of 32 bytes is rejected.
+ */
+PackedPositionFile::PackedPositionFile(const std::string& path) : file_{path, true}, records_{nullptr}, size_{0}, open_{false} {
+    if (!file_.isOpen() || file_.size() % sizeof(PackedPosition) != 0) { return; }
+
+    // Mappings are page aligned, and the fallback buffer is aligned for any type
+    records_ = reinterpret_cast<const PackedPosition*>(file_.data());
+    size_ = file_.size() / sizeof(PackedPosition);
+    open_ = true;
+}
+
+/**
+ * @brief Writes records to a file, replacing it
+ * @param path A const reference to the path of the file
+ * @param records A pointer to the first record
+ * @param count A const reference to the number of records
+ * @return True if every record was written
+ */
+bool PackedPositionFile::write(const std::string& path, const PackedPosition* records, const size_t& count) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) { return false; }
+
+    out.write(reinterpret_cast<const char*>(records), static_cast<std::streamsize>(count * sizeof(PackedPosition)));
+    return static_cast<bool>(out);
+}
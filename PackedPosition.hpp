@@ -0,0 +1,123 @@
+/**
+ * @file PackedPosition.hpp
+ * @brief A fixed-width, 32-byte binary encoding of a chess position, and a memory-mapped file of them.
+ *
+ * A PackedPosition holds what FEN holds, minus the move counters: the occupied squares as a bitboard, a 4-bit
+ * code per occupied square (in the order of the squares), the side to move, the castling rights and the en
+ * passant square. It is a plain struct with no pointers, so a file of them can be mapped and read in place.
+ *
+ * Files are written in the byte order of the host (little-endian on every supported target).
+ */
+
+#pragma once
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "Mailbox.hpp"
+#include "MappedFile.hpp"
+
+struct PackedPosition {
+    // The most pieces a position can hold: one 4-bit code each
+    static constexpr int MAX_PIECES = 32;
+
+    // The fields of `state`
+    static constexpr uint8_t WHITE_TO_MOVE = 0x01;
+    static constexpr int CASTLING_SHIFT = 1;                // The castling rights of ChessBoard::castlingRights, in bits 1-4
+
+    // The value of `enPassant` when there is no en passant square
+    static constexpr uint8_t NO_EN_PASSANT = 0xFF;
+
+    uint64_t occupancy;                     // Bit (row * 8 + col) is set for every occupied square
+    uint8_t pieces[MAX_PIECES / 2];         // The code of the i-th occupied square (lowest first) in nibble i: low nibble first.
+                                            // A code is the low 4 bits of a Mailbox::Piece: the type, plus Mailbox::WHITE.
+    uint8_t state;                          // WHITE_TO_MOVE | castling rights << CASTLING_SHIFT
+    uint8_t enPassant;                      // The en passant square, NO_EN_PASSANT if there is none
+    uint8_t reserved[6];                    // Zero when packed by ChessBoard, and ignored when unpacked (free for a label or score)
+
+    /**
+     * @brief Gets the number of pieces on the board
+     */
+    int pieceCount() const { return __builtin_popcountll(occupancy); }
+
+    /**
+     * @brief Reads the piece on a square, without unpacking the position
+     * @param square A const reference to a square (row * 8 + col)
+     * @return The type & color bits of the piece (Mailbox::typeOf & Mailbox::isWhite read them), Mailbox::EMPTY if there is none
+     */
+    Mailbox::Piece pieceAt(const int& square) const;
+
+    /**
+     * @brief Gets the color of the player to move: ChessPiece::WHITE (1) or ChessPiece::BLACK (0)
+     */
+    int sideToMove() const { return state & WHITE_TO_MOVE; }
+
+    /**
+     * @brief Gets the castling rights, as a mask of ChessBoard::BLACK_KING_CASTLE ... ChessBoard::WHITE_QUEEN_CASTLE
+     */
+    uint8_t castlingRights() const { return (state >> CASTLING_SHIFT) & 0x0F; }
+
+    /**
+     * @brief Gets the en passant square, -1 if there is none
+     */
+    int enPassantSquare() const { return enPassant == NO_EN_PASSANT ? -1 : enPassant; }
+};
+
+static_assert(sizeof(PackedPosition) == 32, "PackedPosition must stay 32 bytes: files of them are read in place");
+static_assert(std::is_trivially_copyable<PackedPosition>::value && std::is_standard_layout<PackedPosition>::value, "PackedPosition must be plain data");
+
+/**
+ * @class PackedPositionFile
+ * @brief A read-only file of PackedPosition records, mapped into memory.
+ *
+ * Records are read in place: operator[] returns a view into the mapping, and nothing is copied or decoded until
+ * ChessBoard::setFromPacked is called on one. The pages are loaded by the OS as they are first touched, so opening
+ * a file of billions of records costs nothing up front.
+ */
+class PackedPositionFile {
+    private:
+        MappedFile file_;
+        const PackedPosition* records_;
+        size_t size_;
+        bool open_;
+
+    public:
+        /**
+         * @brief Maps a file of PackedPosition records
+         * @param path A const reference to the path of the file
+         * @post isOpen() is true if the file was mapped. A file whose size is not a multiple of 32 bytes is rejected.
+         */
+        explicit PackedPositionFile(const std::string& path);
+
+        PackedPositionFile(const PackedPositionFile&) = delete;
+        PackedPositionFile& operator=(const PackedPositionFile&) = delete;
+
+        /**
+         * @brief Determines whether the file was opened
+         */
+        bool isOpen() const { return open_; }
+
+        /**
+         * @brief Gets the number of records
+         */
+        size_t size() const { return size_; }
+
+        /**
+         * @brief Gets a record, in place
+         * @pre index < size()
+         */
+        const PackedPosition& operator[](const size_t& index) const { return records_[index]; }
+
+        const PackedPosition* begin() const { return records_; }
+        const PackedPosition* end() const { return records_ + size_; }
+
+        /**
+         * @brief Writes records to a file, replacing it
+         * @param path A const reference to the path of the file
+         * @param records A pointer to the first record
+         * @param count A const reference to the number of records
+         * @return True if every record was written
+         */
+        static bool write(const std::string& path, const PackedPosition* records, const size_t& count);
+};
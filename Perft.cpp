@@ -0,0 +1,132 @@
+#include "Perft.hpp"
+#include "WorkStealingPool.hpp"
+#include <chrono>
+
+constexpr uint64_t Perft::STARTING_COUNTS[];
+
+/**
+ * @brief Gets the counting speed
+ * @return The leaf nodes counted per second (0 if no time was measured)
+ */
+uint64_t Perft::Report::nodesPerSecond() const {
+    return seconds > 0 ? static_cast<uint64_t>(nodes / seconds) : 0;
+}
+
+/**
+ * @brief Default constructor. Counts on one thread, without a hash table.
+ */
+Perft::Perft() : Perft(Options()) {}
+
+/**
+ * @brief Constructs a counter
+ * @param options A const reference to the Options of every count. The hash table is allocated here, once.
+ */
+Perft::Perft(const Options& options) : options_{options}, table_{}, tableMask_{0} {
+    if (options_.hashMegabytes <= 0) { return; }
+
+    // The largest power of 2 of entries that fits
+    uint64_t entries = 1;
+    while (entries * 2 * sizeof(Entry) <= static_cast<uint64_t>(options_.hashMegabytes) << 20) { entries *= 2; }
+
+    table_ = std::vector<Entry>(entries);
+    tableMask_ = entries - 1;
+}
+
+/**
+ * @brief Counts the leaf nodes below a position
+ *
+ * @param board A (non-const) reference to the position. It is restored before returning.
+ * @param depth A const reference to the number of plies left, at least 1
+ * @return The number of leaf nodes
+ */
+uint64_t Perft::countNodes(ChessBoard& board, const int& depth) {
+    MoveList moves;
+    board.generateLegalMoves(moves);
+
+    // Bulk count: the leaves are the moves themselves
+    if (depth == 1) { return moves.size(); }
+
+    Entry* entry = nullptr;
+    if (!table_.empty()) {
+        entry = &table_[board.getHash() & tableMask_];
+
+        uint64_t data = entry->data.load(std::memory_order_relaxed);
+        uint64_t check = entry->check.load(std::memory_order_relaxed);
+        if ((check ^ data) == board.getHash() && static_cast<int>(data & 0xFF) == depth) { return data >> 8; }
+    }
+
+    uint64_t nodes = 0;
+    for (const Move& move : moves) {
+        ChessBoard::UndoRecord undo = board.makeMove(move);
+        nodes += countNodes(board, depth - 1);
+        board.unmakeMove(undo);
+    }
+
+    if (entry) {
+        uint64_t data = (nodes << 8) | static_cast<uint64_t>(depth);
+        entry->data.store(data, std::memory_order_relaxed);
+        entry->check.store(board.getHash() ^ data, std::memory_order_relaxed);
+    }
+
+    return nodes;
+}
+
+/**
+ * @brief Counts the leaf nodes of the legal move tree, with a breakdown per root move
+ *
+ * @param board A const reference to the root position (it is copied, never changed)
+ * @param depth A const reference to the number of plies to walk
+ * @return The Report of the count. A depth below 1 counts the root as the only node, with no divisions.
+ */
+Perft::Report Perft::run(const ChessBoard& board, const int& depth) {
+    Report report{depth, 1, 0, {}};
+    if (depth < 1) { return report; }
+
+    auto start = std::chrono::steady_clock::now();
+
+    MoveList moves;
+    board.generateLegalMoves(moves);
+    for (const Move& move : moves) { report.divisions.push_back(Division{move, 1}); }
+
+    if (depth > 1) {
+        WorkStealingPool pool(options_.threads);
+
+        // Each root move is a task on its own copy of the board (a copy is a few cache lines, no ChessPiece is copied)
+        std::vector<WorkStealingPool::Task> tasks;
+        for (Division& division : report.divisions) {
+            tasks.push_back([this, &board, &division, &depth] (const int&) {
+                ChessBoard child(board);
+                child.makeMove(division.move);
+                division.nodes = countNodes(child, depth - 1);
+            });
+        }
+        pool.run(tasks);
+    }
+
+    report.nodes = 0;
+    for (const Division& division : report.divisions) { report.nodes += division.nodes; }
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    return report;
+}
+
+/**
+ * @brief Counts the leaf nodes of the legal move tree
+ *
+ * @param board A const reference to the root position (it is copied, never changed)
+ * @param depth A const reference to the number of plies to walk
+ * @return The number of leaf nodes
+ */
+uint64_t Perft::count(const ChessBoard& board, const int& depth) {
+    return run(board, depth).nodes;
+}
+
+/**
+ * @brief Empties the hash table, so that the next count reuses nothing
+ */
+void Perft::clearHash() {
+    for (Entry& entry : table_) {
+        entry.check.store(0, std::memory_order_relaxed);
+        entry.data.store(0, std::memory_order_relaxed);
+    }
+}
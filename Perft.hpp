@@ -0,0 +1,114 @@
+/**
+ * @class Perft
+ * @brief Counts the leaf nodes of the legal move tree of a ChessBoard, to validate & time the move generator.
+ *
+ * The last ply is bulk-counted: the size of the legal move list is added without playing its moves.
+ * Root moves are split across a WorkStealingPool, each worker walking its own copy of the board with
+ * makeMove / unmakeMove. An optional hash table, shared by every worker without locks, reuses the counts
+ * of subtrees reached through transpositions.
+ */
+
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include "ChessBoard.hpp"
+
+class Perft {
+    public:
+        /**
+         * @brief How a count is run
+         *  - threads: The number of worker threads the root moves are split across. If not positive, the hardware concurrency is used.
+         *  - hashMegabytes: The size of the transposition table, 0 to count without one
+         */
+        struct Options {
+            int threads = 1;
+            int hashMegabytes = 0;
+        };
+
+        // The leaf nodes below one root move
+        struct Division {
+            Move move;
+            uint64_t nodes;
+        };
+
+        /**
+         * @brief The result of a count
+         */
+        struct Report {
+            int depth;
+            uint64_t nodes;
+            double seconds;
+            std::vector<Division> divisions;   // One per legal root move, in generation order
+
+            /**
+             * @brief Gets the counting speed
+             * @return The leaf nodes counted per second (0 if no time was measured)
+             */
+            uint64_t nodesPerSecond() const;
+        };
+
+    private:
+        /**
+         * @brief A cached subtree count. `data` packs the count (above bit 8) and the depth (lowest 8 bits),
+         *      and `check` holds hash ^ data, so an entry torn by a concurrent store fails its check instead of being misread.
+         */
+        struct Entry {
+            std::atomic<uint64_t> check;
+            std::atomic<uint64_t> data;
+        };
+
+        Options options_;
+        std::vector<Entry> table_;
+        uint64_t tableMask_;            // The number of entries of table_ minus 1 (a power of 2 minus 1), unused if it is empty
+
+        /**
+         * @brief Counts the leaf nodes below a position
+         *
+         * @param board A (non-const) reference to the position. It is restored before returning.
+         * @param depth A const reference to the number of plies left, at least 1
+         * @return The number of leaf nodes
+         */
+        uint64_t countNodes(ChessBoard& board, const int& depth);
+
+    public:
+        /**
+         * @brief Default constructor. Counts on one thread, without a hash table.
+         */
+        Perft();
+
+        /**
+         * @brief Constructs a counter
+         * @param options A const reference to the Options of every count. The hash table is allocated here, once.
+         */
+        Perft(const Options& options);
+
+        /**
+         * @brief Counts the leaf nodes of the legal move tree, with a breakdown per root move
+         *
+         * @param board A const reference to the root position (it is copied, never changed)
+         * @param depth A const reference to the number of plies to walk
+         * @return The Report of the count. A depth below 1 counts the root as the only node, with no divisions.
+         */
+        Report run(const ChessBoard& board, const int& depth);
+
+        /**
+         * @brief Counts the leaf nodes of the legal move tree
+         *
+         * @param board A const reference to the root position (it is copied, never changed)
+         * @param depth A const reference to the number of plies to walk
+         * @return The number of leaf nodes
+         */
+        uint64_t count(const ChessBoard& board, const int& depth);
+
+        /**
+         * @brief Empties the hash table, so that the next count reuses nothing
+         */
+        void clearHash();
+
+        /**
+         * @brief The reference leaf counts of ChessBoard(), for depths 0 to 6
+         */
+        static constexpr uint64_t STARTING_COUNTS[] = {1, 20, 400, 8902, 197281, 4865609, 119060324};
+};
@@ -0,0 +1,265 @@
+#include "PgnPipeline.hpp"
+#include "BoundedQueue.hpp"
+#include "MappedFile.hpp"
+#include "WorkStealingPool.hpp"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+
+namespace {
+    // Where a game without a FEN tag starts
+    constexpr std::string_view STANDARD_START = "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1";
+
+    bool isBlank(const char& c) {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    /**
+     * @brief Reads a result tag value or termination marker
+     * @return The Result it names, UNKNOWN for "*" or anything else
+     */
+    PgnPipeline::Result resultOf(const std::string_view& text) {
+        if (text == "1-0") { return PgnPipeline::WHITE_WINS; }
+        if (text == "0-1") { return PgnPipeline::BLACK_WINS; }
+        if (text == "1/2-1/2") { return PgnPipeline::DRAW; }
+        return PgnPipeline::UNKNOWN;
+    }
+};
+
+/**
+ * @brief Constructs a pipeline with the default Options
+ */
+PgnPipeline::PgnPipeline() : PgnPipeline(Options()) {}
+
+/**
+ * @brief Constructs a pipeline
+ * @param options A const reference to the Options of the runs
+ */
+PgnPipeline::PgnPipeline(const Options& options) : options_{options} {}
+
+/**
+ * @brief Cuts PGN text into games, in one pass
+ *
+ * A game starts at its first tag line, and ends where a tag line follows its movetext (or at the end of `text`).
+ *
+ * @param text A const reference to the PGN text
+ * @param visitor A const reference to a callback receiving the text of each game, in order. Returning false stops the scan.
+ * @return The number of games visited
+ */
+uint64_t PgnPipeline::splitGames(const std::string_view& text, const std::function<bool(const std::string_view&)>& visitor) {
+    uint64_t count = 0;
+    size_t start = std::string_view::npos;
+    bool inMovetext = false;
+
+    for (size_t line = 0; line < text.size(); ) {
+        size_t end = text.find('\n', line);
+        if (end == std::string_view::npos) { end = text.size(); }
+
+        size_t first = line;
+        while (first < end && isBlank(text[first])) { first++; }
+
+        if (first < end && text[first] == '[') {
+            // A tag after movetext starts the next game
+            if (inMovetext) {
+                count++;
+                if (!visitor(text.substr(start, line - start))) { return count; }
+                start = std::string_view::npos;
+                inMovetext = false;
+            }
+            if (start == std::string_view::npos) { start = line; }
+        } else if (first < end && text[first] != '%') {     // Lines starting with '%' are escaped
+            if (start == std::string_view::npos) { start = line; }
+            inMovetext = true;
+        }
+
+        line = end + 1;
+    }
+
+    if (start != std::string_view::npos) {
+        count++;
+        visitor(text.substr(start));
+    }
+
+    return count;
+}
+
+/**
+ * @brief Replays one game
+ *
+ * The game starts from its FEN tag if it has one, from the standard starting position (WHITE to move) otherwise.
+ * Move numbers, comments, variations & NAGs are skipped. Replay stops at the first move that cannot be played.
+ *
+ * @param text A const reference to the text of the game: its tags, then its movetext
+ * @param board A (non-const) reference to a board to replay on, holding the final position afterwards
+ * @param game A (non-const) reference to the Game to fill (its index is left unchanged)
+ * @param positions A const reference to a boolean, true to pack the positions of the game into game.positions
+ * @return The value written to game.complete
+ */
+bool PgnPipeline::replayGame(const std::string_view& text, ChessBoard& board, Game& game, const bool& positions) {
+    game.result = UNKNOWN;
+    game.plies = 0;
+    game.complete = false;
+    game.positions.clear();
+
+    // Tag pairs: [Name "Value"]
+    size_t i = 0;
+    std::string_view fen = STANDARD_START;
+    while (true) {
+        while (i < text.size() && isBlank(text[i])) { i++; }
+        if (i >= text.size() || text[i] != '[') { break; }
+
+        size_t close = text.find(']', i);
+        if (close == std::string_view::npos) { close = text.size(); }
+        const std::string_view tag = text.substr(i + 1, close - i - 1);
+        i = close + 1;
+
+        const size_t open = tag.find('"');
+        const size_t last = tag.rfind('"');
+        if (open == std::string_view::npos || last == open) { continue; }
+
+        const std::string_view name = tag.substr(0, tag.find(' '));
+        const std::string_view value = tag.substr(open + 1, last - open - 1);
+        if (name == "FEN") { fen = value; }
+        else if (name == "Result") { game.result = resultOf(value); }
+    }
+
+    if (!board.setFromFen(fen)) { return false; }
+
+    PackedPosition packed;
+    while (i < text.size()) {
+        const char c = text[i];
+        if (isBlank(c)) {
+            i++;
+            continue;
+        }
+
+        // Comments, variations & NAGs
+        if (c == '{') {
+            i = std::min(text.find('}', i), text.size()) + 1;
+            continue;
+        }
+        if (c == ';') {
+            i = std::min(text.find('\n', i), text.size()) + 1;
+            continue;
+        }
+        if (c == '(') {
+            int depth = 0;
+            for (; i < text.size(); i++) {
+                if (text[i] == '{') { i = std::min(text.find('}', i), text.size() - 1); }
+                else if (text[i] == '(') { depth++; }
+                else if (text[i] == ')' && --depth == 0) { break; }
+            }
+            i++;
+            continue;
+        }
+        if (c == '$') {
+            for (i++; i < text.size() && text[i] >= '0' && text[i] <= '9'; i++) {}
+            continue;
+        }
+
+        size_t end = i;
+        while (end < text.size() && !isBlank(text[end]) && text[end] != '{' && text[end] != '(' && text[end] != ')' && text[end] != ';') { end++; }
+        std::string_view token = text.substr(i, end - i);
+        i = end;
+
+        // A termination marker ends the game, and overrides the result tag when it names a result
+        if (token == "*" || token == "1-0" || token == "0-1" || token == "1/2-1/2") {
+            if (token != "*") { game.result = resultOf(token); }
+            break;
+        }
+
+        // A move number, possibly glued to its move ("12.e4", "12...Nf6")
+        size_t digits = 0;
+        while (digits < token.size() && token[digits] >= '0' && token[digits] <= '9') { digits++; }
+        if (digits > 0 && (digits == token.size() || token[digits] == '.')) {
+            token.remove_prefix(digits);
+            while (!token.empty() && token.front() == '.') { token.remove_prefix(1); }
+            if (token.empty()) { continue; }
+        }
+
+        const Move move = board.moveFromSan(token);
+        if (move == Move::none()) { return false; }
+
+        if (positions && board.writePacked(packed)) { game.positions.push_back(packed); }
+        board.makeMove(move);
+        game.plies++;
+    }
+
+    if (positions && board.writePacked(packed)) { game.positions.push_back(packed); }
+
+    game.complete = true;
+    return true;
+}
+
+/**
+ * @brief Replays every game of a PGN file, and blocks until the consumer has received them all
+ *
+ * @param path A const reference to the path of the file
+ * @param consumer A const reference to the callback receiving each Game. It runs on one thread at a time.
+ * @param summary A (non-const) reference set to the Summary of the run
+ * @return True if the file was read. False if it could not be opened (`summary` is left unchanged).
+ */
+bool PgnPipeline::run(const std::string& path, const Consumer& consumer, Summary& summary) const {
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    MappedFile file(path, true);
+    if (!file.isOpen()) { return false; }
+
+    const int parsers = options_.threads > 0 ? options_.threads : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+    BoundedQueue<GameText> texts(options_.queueCapacity);
+    BoundedQueue<Game> games(options_.queueCapacity);
+    std::atomic<int> running{parsers};
+
+    uint64_t found = 0;         // Only written by the splitter
+    uint64_t incomplete = 0;    // Only written by the consumer
+    uint64_t plies = 0;
+
+    std::vector<WorkStealingPool::Task> tasks;
+
+    // Stage 1: cut the file into games
+    tasks.push_back([&file, &texts, &found] (const int&) {
+        uint64_t index = 0;
+        found = splitGames(file.view(), [&texts, &index] (const std::string_view& text) { return texts.push(GameText{index++, text}); });
+        texts.close();
+    });
+
+    // Stage 2: replay the games, each parser on a board of its own. The last parser to finish closes the output.
+    for (int parser = 0; parser < parsers; parser++) {
+        tasks.push_back([this, &texts, &games, &running] (const int&) {
+            ChessBoard board;
+            GameText text;
+            while (texts.pop(text)) {
+                Game game;
+                game.index = text.index;
+                replayGame(text.text, board, game, options_.positions);
+                games.push(std::move(game));
+            }
+
+            if (running.fetch_sub(1) == 1) { games.close(); }
+        });
+    }
+
+    // Stage 3: hand the games to the consumer
+    tasks.push_back([&games, &consumer, &incomplete, &plies] (const int&) {
+        Game game;
+        while (games.pop(game)) {
+            incomplete += !game.complete;
+            plies += game.plies;
+            if (consumer) { consumer(game); }
+        }
+    });
+
+    // Every stage blocks on the others, so each needs a thread of its own
+    WorkStealingPool pool(static_cast<int>(tasks.size()));
+    pool.run(tasks);
+
+    summary.games = found;
+    summary.incomplete = incomplete;
+    summary.plies = plies;
+    summary.bytes = file.size();
+    summary.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    return true;
+}
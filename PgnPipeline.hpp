@@ -0,0 +1,123 @@
+/**
+ * @class PgnPipeline
+ * @brief Replays every game of a PGN file through ChessBoard, on several threads.
+ *
+ * The file is memory-mapped and flows through three stages, joined by BoundedQueues:
+ *  1. One thread scans the file once, cutting it into games. A game is handed on as a view into the mapping: nothing is copied.
+ *  2. Parser threads read the tags & the movetext of each game, and replay its SAN moves with makeMove on a board of their own.
+ *  3. One thread hands each replayed Game to the consumer callback.
+ *
+ * The queues hold a bounded number of games, so memory stays flat however large the file: a stage that runs
+ * ahead waits for the next one. Games reach the consumer in whatever order the parsers finish them (see Game::index).
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include "ChessBoard.hpp"
+#include "PackedPosition.hpp"
+
+class PgnPipeline {
+    public:
+        // The outcome of a game, as its result tag or termination marker gives it
+        enum Result : uint8_t { UNKNOWN, WHITE_WINS, BLACK_WINS, DRAW };
+
+        /**
+         * @brief How to run the pipeline
+         *  - threads: The number of parser threads. If not positive, the hardware concurrency is used.
+         *  - queueCapacity: The most games waiting between two stages
+         *  - positions: True to pack the position before every move (and the final one) into Game::positions
+         */
+        struct Options {
+            int threads = 0;
+            size_t queueCapacity = 1024;
+            bool positions = true;
+        };
+
+        /**
+         * @brief A replayed game
+         */
+        struct Game {
+            uint64_t index;                         // The order of the game in the file, from 0
+            Result result;
+            int plies;                              // The number of moves replayed
+            bool complete;                          // False if a move could not be read or played, or the start position was invalid
+            std::vector<PackedPosition> positions;  // The position before each move, then the final one (if Options::positions)
+        };
+
+        // Receives each replayed game, on a single thread
+        typedef std::function<void(const Game&)> Consumer;
+
+        /**
+         * @brief What a run went through
+         */
+        struct Summary {
+            uint64_t games;             // Games found in the file
+            uint64_t incomplete;        // Games not replayed to their end
+            uint64_t plies;             // Moves replayed, over all games
+            size_t bytes;               // The size of the file
+            double seconds;
+        };
+
+    private:
+        /**
+         * @brief The text of one game, handed from the splitter to the parsers
+         */
+        struct GameText {
+            uint64_t index;
+            std::string_view text;
+        };
+
+        Options options_;
+
+    public:
+        /**
+         * @brief Constructs a pipeline with the default Options
+         */
+        PgnPipeline();
+
+        /**
+         * @brief Constructs a pipeline
+         * @param options A const reference to the Options of the runs
+         */
+        explicit PgnPipeline(const Options& options);
+
+        /**
+         * @brief Replays every game of a PGN file, and blocks until the consumer has received them all
+         *
+         * @param path A const reference to the path of the file
+         * @param consumer A const reference to the callback receiving each Game. It runs on one thread at a time.
+         * @param summary A (non-const) reference set to the Summary of the run
+         * @return True if the file was read. False if it could not be opened (`summary` is left unchanged).
+         */
+        bool run(const std::string& path, const Consumer& consumer, Summary& summary) const;
+
+        /**
+         * @brief Cuts PGN text into games, in one pass
+         *
+         * A game starts at its first tag line, and ends where a tag line follows its movetext (or at the end of `text`).
+         *
+         * @param text A const reference to the PGN text
+         * @param visitor A const reference to a callback receiving the text of each game, in order. Returning false stops the scan.
+         * @return The number of games visited
+         */
+        static uint64_t splitGames(const std::string_view& text, const std::function<bool(const std::string_view&)>& visitor);
+
+        /**
+         * @brief Replays one game
+         *
+         * The game starts from its FEN tag if it has one, from the standard starting position (WHITE to move) otherwise.
+         * Move numbers, comments, variations & NAGs are skipped. Replay stops at the first move that cannot be played.
+         *
+         * @param text A const reference to the text of the game: its tags, then its movetext
+         * @param board A (non-const) reference to a board to replay on, holding the final position afterwards
+         * @param game A (non-const) reference to the Game to fill (its index is left unchanged)
+         * @param positions A const reference to a boolean, true to pack the positions of the game into game.positions
+         * @return The value written to game.complete
+         */
+        static bool replayGame(const std::string_view& text, ChessBoard& board, Game& game, const bool& positions);
+};
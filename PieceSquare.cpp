@@ -0,0 +1,147 @@
+#include "PieceSquare.hpp"
+
+namespace PieceSquare {
+    namespace detail {
+        // The material of each type (NONE, PAWN, KNIGHT, BISHOP, ROOK, QUEEN, KING)
+        constexpr std::array<int, TYPES> MATERIAL = {0, 100, 320, 330, 500, 900, 0};
+        constexpr std::array<int, TYPES> PHASE = {0, 0, 1, 1, 2, 4, 0};
+
+        typedef std::array<int, SQUARES> Table;
+
+        // Written as WHITE sees the board: the 8th rank first, and a to h files left to right
+        constexpr Table PAWN_TABLE = {
+             0,  0,  0,  0,  0,  0,  0,  0,
+            50, 50, 50, 50, 50, 50, 50, 50,
+            10, 10, 20, 30, 30, 20, 10, 10,
+             5,  5, 10, 25, 25, 10,  5,  5,
+             0,  0,  0, 20, 20,  0,  0,  0,
+             5, -5,-10,  0,  0,-10, -5,  5,
+             5, 10, 10,-20,-20, 10, 10,  5,
+             0,  0,  0,  0,  0,  0,  0,  0
+        };
+
+        constexpr Table KNIGHT_TABLE = {
+            -50,-40,-30,-30,-30,-30,-40,-50,
+            -40,-20,  0,  0,  0,  0,-20,-40,
+            -30,  0, 10, 15, 15, 10,  0,-30,
+            -30,  5, 15, 20, 20, 15,  5,-30,
+            -30,  0, 15, 20, 20, 15,  0,-30,
+            -30,  5, 10, 15, 15, 10,  5,-30,
+            -40,-20,  0,  5,  5,  0,-20,-40,
+            -50,-40,-30,-30,-30,-30,-40,-50
+        };
+
+        constexpr Table BISHOP_TABLE = {
+            -20,-10,-10,-10,-10,-10,-10,-20,
+            -10,  0,  0,  0,  0,  0,  0,-10,
+            -10,  0,  5, 10, 10,  5,  0,-10,
+            -10,  5,  5, 10, 10,  5,  5,-10,
+            -10,  0, 10, 10, 10, 10,  0,-10,
+            -10, 10, 10, 10, 10, 10, 10,-10,
+            -10,  5,  0,  0,  0,  0,  5,-10,
+            -20,-10,-10,-10,-10,-10,-10,-20
+        };
+
+        constexpr Table ROOK_TABLE = {
+              0,  0,  0,  0,  0,  0,  0,  0,
+              5, 10, 10, 10, 10, 10, 10,  5,
+             -5,  0,  0,  0,  0,  0,  0, -5,
+             -5,  0,  0,  0,  0,  0,  0, -5,
+             -5,  0,  0,  0,  0,  0,  0, -5,
+             -5,  0,  0,  0,  0,  0,  0, -5,
+             -5,  0,  0,  0,  0,  0,  0, -5,
+              0,  0,  0,  5,  5,  0,  0,  0
+        };
+
+        constexpr Table QUEEN_TABLE = {
+            -20,-10,-10, -5, -5,-10,-10,-20,
+            -10,  0,  0,  0,  0,  0,  0,-10,
+            -10,  0,  5,  5,  5,  5,  0,-10,
+             -5,  0,  5,  5,  5,  5,  0, -5,
+              0,  0,  5,  5,  5,  5,  0, -5,
+            -10,  5,  5,  5,  5,  5,  0,-10,
+            -10,  0,  5,  0,  0,  0,  0,-10,
+            -20,-10,-10, -5, -5,-10,-10,-20
+        };
+
+        // The king hides behind its pawns while the board is full, and walks to the center once it empties
+        constexpr Table KING_MIDDLEGAME_TABLE = {
+            -30,-40,-40,-50,-50,-40,-40,-30,
+            -30,-40,-40,-50,-50,-40,-40,-30,
+            -30,-40,-40,-50,-50,-40,-40,-30,
+            -30,-40,-40,-50,-50,-40,-40,-30,
+            -20,-30,-30,-40,-40,-30,-30,-20,
+            -10,-20,-20,-20,-20,-20,-20,-10,
+             20, 20,  0,  0,  0,  0, 20, 20,
+             20, 30, 10,  0,  0, 10, 30, 20
+        };
+
+        constexpr Table KING_ENDGAME_TABLE = {
+            -50,-40,-30,-20,-20,-30,-40,-50,
+            -30,-20,-10,  0,  0,-10,-20,-30,
+            -30,-10, 20, 30, 30, 20,-10,-30,
+            -30,-10, 30, 40, 40, 30,-10,-30,
+            -30,-10, 30, 40, 40, 30,-10,-30,
+            -30,-10, 20, 30, 30, 20,-10,-30,
+            -30,-30,  0,  0,  0,  0,-30,-30,
+            -50,-30,-30,-30,-30,-30,-30,-50
+        };
+
+        typedef std::array<std::array<std::array<Score, SQUARES>, TYPES>, COLORS> ScoreTable;
+
+        /**
+         * @brief Builds the worth of every (color, type, square), so a lookup is a single load
+         */
+        constexpr ScoreTable makeScores() {
+            const Table* middlegame[TYPES] = {nullptr, &PAWN_TABLE, &KNIGHT_TABLE, &BISHOP_TABLE, &ROOK_TABLE, &QUEEN_TABLE, &KING_MIDDLEGAME_TABLE};
+            const Table* endgame[TYPES] = {nullptr, &PAWN_TABLE, &KNIGHT_TABLE, &BISHOP_TABLE, &ROOK_TABLE, &QUEEN_TABLE, &KING_ENDGAME_TABLE};
+
+            ScoreTable scores{};
+            for (int color = 0; color < COLORS; color++) {
+                for (int type = 1; type < TYPES; type++) {
+                    for (int square = 0; square < SQUARES; square++) {
+                        // Row r is rank 8 - r and column c is file 'h' - c. WHITE (color 1) reads its table with the files
+                        // mirrored, BLACK with both ranks & files mirrored.
+                        int index = color == 1 ? square ^ 7 : SQUARES - 1 - square;
+                        scores[color][type][square] = Score{MATERIAL[type] + (*middlegame[type])[index], MATERIAL[type] + (*endgame[type])[index]};
+                    }
+                }
+            }
+
+            return scores;
+        }
+
+        constexpr ScoreTable SCORES = makeScores();
+    };
+};
+
+/**
+ * @brief Gets the worth of a piece on a square
+ * @param color A const reference to the color of the piece: ChessPiece::BLACK or ChessPiece::WHITE
+ * @param type A const reference to the type of the piece, as a PieceType value. 0 (NONE) is worth nothing.
+ * @param square A const reference to the square of the piece (row * 8 + col)
+ * @return The material & piece-square value of the piece, for its own side
+ */
+constexpr PieceSquare::Score PieceSquare::score(const int& color, const int& type, const int& square) {
+    return detail::SCORES[color][type][square];
+}
+
+/**
+ * @brief Gets how much a piece counts towards the game phase
+ * @param type A const reference to the type of the piece, as a PieceType value
+ * @return 1 for knights & bishops, 2 for rooks, 4 for queens, 0 otherwise
+ */
+constexpr int PieceSquare::phaseOf(const int& type) {
+    return detail::PHASE[type];
+}
+
+/**
+ * @brief Blends a score by the game phase
+ * @param score A const reference to a Score
+ * @param phase A const reference to the game phase, clamped to [0, MAX_PHASE]
+ * @return The middle game value at MAX_PHASE, the end game value at 0, and a linear mix in between
+ */
+constexpr int PieceSquare::taper(const Score& score, const int& phase) {
+    int clamped = phase < 0 ? 0 : (phase > MAX_PHASE ? MAX_PHASE : phase);
+    return (score.middlegame * clamped + score.endgame * (MAX_PHASE - clamped)) / MAX_PHASE;
+}
@@ -0,0 +1,67 @@
+/**
+ * @namespace PieceSquare
+ * @brief The worth of each piece on each square: its material plus a piece-square bonus, in centipawns.
+ *
+ * Each piece is worth a middle game score and an end game score. An evaluation blends the two by the game phase,
+ * the non-pawn material left on the board (see Evaluator). Since the worth of a piece only depends on its own
+ * square, ChessBoard keeps the sum for each color up to date as pieces are put & removed, instead of summing
+ * all 64 squares at every leaf.
+ *
+ * The tables follow the "simplified evaluation function" of the chess programming literature. They are written
+ * from WHITE's side of the board (its back rank last), and read for BLACK through a vertical flip.
+ */
+
+ #pragma once
+ #include <array>
+ #include <cstdint>
+ namespace PieceSquare {
+     // The number of squares on the chessboard
+     constexpr int SQUARES = 64;
+
+     // The number of piece types (indexed as PieceType, NONE included) and colors (indexed as ChessPiece::Color)
+     constexpr int TYPES = 7;
+     constexpr int COLORS = 2;
+
+     // The game phase with every knight, bishop, rook & queen on the board (see phaseOf)
+     constexpr int MAX_PHASE = 24;
+
+     /**
+      * @brief A middle game & end game pair of centipawn values
+      */
+     struct Score {
+         int middlegame;
+         int endgame;
+
+         constexpr Score& operator+=(const Score& other) { middlegame += other.middlegame; endgame += other.endgame; return *this; }
+         constexpr Score& operator-=(const Score& other) { middlegame -= other.middlegame; endgame -= other.endgame; return *this; }
+         constexpr Score operator+(const Score& other) const { return Score{middlegame + other.middlegame, endgame + other.endgame}; }
+         constexpr Score operator-(const Score& other) const { return Score{middlegame - other.middlegame, endgame - other.endgame}; }
+         constexpr bool operator==(const Score& other) const { return middlegame == other.middlegame && endgame == other.endgame; }
+     };
+
+     /**
+      * @brief Gets the worth of a piece on a square
+      * @param color A const reference to the color of the piece: ChessPiece::BLACK or ChessPiece::WHITE
+      * @param type A const reference to the type of the piece, as a PieceType value. 0 (NONE) is worth nothing.
+      * @param square A const reference to the square of the piece (row * 8 + col)
+      * @return The material & piece-square value of the piece, for its own side
+      */
+     constexpr Score score(const int& color, const int& type, const int& square);
+
+     /**
+      * @brief Gets how much a piece counts towards the game phase
+      * @param type A const reference to the type of the piece, as a PieceType value
+      * @return 1 for knights & bishops, 2 for rooks, 4 for queens, 0 otherwise
+      */
+     constexpr int phaseOf(const int& type);
+
+     /**
+      * @brief Blends a score by the game phase
+      * @param score A const reference to a Score
+      * @param phase A const reference to the game phase, clamped to [0, MAX_PHASE]
+      * @return The middle game value at MAX_PHASE, the end game value at 0, and a linear mix in between
+      */
+     constexpr int taper(const Score& score, const int& phase);
+ };
+
+ #include "PieceSquare.cpp"
@@ -0,0 +1,345 @@
+#include "PositionDedup.hpp"
+#include "MappedFile.hpp"
+#include "Transform.hpp"
+#include <queue>
+#include <cstdio>
+#include <fstream>
+#include <utility>
+#include <algorithm>
+#include <unistd.h>
+
+namespace {
+    // The slots a shard starts with (fewer if the memory budget is smaller)
+    constexpr size_t INITIAL_SLOTS = 1024;
+
+    // The columns of a row
+    constexpr int BOARD_LENGTH = 8;
+
+    // The column both kings start on, as on ChessBoard
+    constexpr int KING_COLUMN = 3;
+
+    // The castling rights of the color flip: BLACK's rights become WHITE's and back
+    constexpr int flipCastling(const int& rights) {
+        return ((rights & (ChessBoard::BLACK_KING_CASTLE | ChessBoard::BLACK_QUEEN_CASTLE)) << 2) | (rights >> 2);
+    }
+};
+
+std::atomic<uint64_t> PositionDedup::instances_{0};
+
+/**
+ * @brief Constructs an empty set with the default Options
+ */
+PositionDedup::PositionDedup() : PositionDedup(Options()) {}
+
+/**
+ * @brief Constructs an empty set
+ * @param options A const reference to the Options of the set
+ */
+PositionDedup::PositionDedup(const Options& options) : options_{options}, positions_{0}, spills_{0}, spillFailed_{false}, instance_{instances_++} {
+    int bits = 0;
+    while ((1 << bits) < options_.shards && bits < 16) { bits++; }
+    shardShift_ = 64 - bits;
+
+    // The largest power of 2 of slots that fits a shard's share of the budget
+    const size_t budget = (options_.memoryMegabytes << 20) >> bits;
+    maxSlots_ = 16;
+    while (maxSlots_ * 2 * sizeof(Entry) <= budget) { maxSlots_ *= 2; }
+
+    for (int i = 0; i < (1 << bits); i++) {
+        shards_.push_back(std::make_unique<Shard>());
+        shards_.back()->entries.assign(std::min(INITIAL_SLOTS, maxSlots_), Entry{0, 0});
+    }
+}
+
+/**
+ * @brief Destructor. Removes the run files.
+ */
+PositionDedup::~PositionDedup() {
+    for (const std::unique_ptr<Shard>& shard : shards_) {
+        for (const std::string& run : shard->runs) { std::remove(run.c_str()); }
+    }
+}
+
+/**
+ * @brief Computes the Zobrist hash the color flip of a position would have, without building it
+ * @param board A const reference to the position
+ * @return The hash of the flipped position, as ChessBoard::getHash would give it
+ */
+Zobrist::Key PositionDedup::colorFlippedHash(const ChessBoard& board) {
+    Zobrist::Key hash = 0;
+
+    // The pieces of each color & type, mirrored a whole bitboard at a time, are hashed as the other color's
+    for (int color = ChessPiece::BLACK; color <= ChessPiece::WHITE; color++) {
+        for (int type = static_cast<int>(PieceType::PAWN); type <= static_cast<int>(PieceType::KING); type++) {
+            const Attacks::Mask pieces = board.getPieces(static_cast<ChessPiece::Color>(color), static_cast<PieceType>(type));
+            for (uint64_t flipped = Transform::flipAcrossHorizontal(Transform::PackedBoard{pieces}).bits; flipped; flipped &= flipped - 1) {
+                hash ^= Zobrist::piece(color ^ 1, type, __builtin_ctzll(flipped));
+            }
+        }
+    }
+
+    // The en passant square keeps its column, and the other player is to move
+    hash ^= Zobrist::castling(flipCastling(board.castlingRights()));
+    if (board.getEnPassantSquare() != -1) { hash ^= Zobrist::enPassant(board.getEnPassantSquare() % BOARD_LENGTH); }
+    if (board.sideToMove() == ChessPiece::BLACK) { hash ^= Zobrist::side(); }
+
+    return hash;
+}
+
+/**
+ * @brief Computes the key shared by a position and its color flip
+ * @param board A const reference to the position
+ * @return The lower of the position's hash and of its color flip's hash
+ */
+Zobrist::Key PositionDedup::canonicalKey(const ChessBoard& board) {
+    return std::min(board.getHash(), colorFlippedHash(board));
+}
+
+/**
+ * @brief Computes the key shared by a position and its color flip, in one pass over a packed position (without unpacking it)
+ *
+ * The castling rights & en passant square are read as setFromPacked reads them: a right whose king or rook is not
+ * home, and an en passant square no pawn can capture onto, are dropped before hashing.
+ *
+ * @param packed A const reference to the position
+ * @return The same key as canonicalKey of the board setFromPacked unpacks the position to. Records setFromPacked 
+ *      rejects still get a key, from their pieces & the fields that pass the rules above.
+ */
+Zobrist::Key PositionDedup::canonicalKey(const PackedPosition& packed) {
+    Zobrist::Key hash = 0;
+    Zobrist::Key flipped = 0;
+
+    // The squares of each color's pawns, kings & rooks, to check the castling rights & en passant square against
+    Attacks::Mask pieces[Mailbox::KING + 1][2] = {};
+
+    // Square ^ 56 is where flipAcrossHorizontal moves a square: the same column, on the mirrored row
+    int index = 0;
+    for (uint64_t occupied = packed.occupancy; occupied; occupied &= occupied - 1, index++) {
+        const int square = __builtin_ctzll(occupied);
+        const Mailbox::Piece code = (packed.pieces[index / 2] >> (4 * (index % 2))) & 0x0F;
+        const int color = Mailbox::isWhite(code) ? ChessPiece::WHITE : ChessPiece::BLACK;
+        const int type = Mailbox::typeOf(code);
+
+        hash ^= Zobrist::piece(color, type, square);
+        flipped ^= Zobrist::piece(color ^ 1, type, square ^ 56);
+        if (type <= Mailbox::KING) { pieces[type][color] |= Attacks::squareMask(square); }
+    }
+
+    // A castling right needs its king & rook home
+    uint8_t rights = 0;
+    for (const uint8_t& right : {ChessBoard::BLACK_KING_CASTLE, ChessBoard::BLACK_QUEEN_CASTLE, ChessBoard::WHITE_KING_CASTLE, ChessBoard::WHITE_QUEEN_CASTLE}) {
+        const int color = right & (ChessBoard::WHITE_KING_CASTLE | ChessBoard::WHITE_QUEEN_CASTLE) ? ChessPiece::WHITE : ChessPiece::BLACK;
+        const int home = color == ChessPiece::WHITE ? BOARD_LENGTH - 1 : 0;
+        const int rookCol = right & (ChessBoard::BLACK_KING_CASTLE | ChessBoard::WHITE_KING_CASTLE) ? 0 : BOARD_LENGTH - 1;
+        if ((packed.castlingRights() & right) && (pieces[Mailbox::KING][color] & Attacks::squareMask(home * BOARD_LENGTH + KING_COLUMN)) &&
+            (pieces[Mailbox::ROOK][color] & Attacks::squareMask(home * BOARD_LENGTH + rookCol))) { rights |= right; }
+    }
+    hash ^= Zobrist::castling(rights);
+    flipped ^= Zobrist::castling(flipCastling(rights));
+
+    // An en passant square only counts when a pawn of the player to move can capture onto it
+    const int skipped = packed.enPassantSquare();
+    const int mover = packed.sideToMove() ^ 1;
+    if (skipped >= 0 && skipped < Zobrist::SQUARES && (Attacks::pawnAttacks(skipped, mover == ChessPiece::BLACK) & pieces[Mailbox::PAWN][mover ^ 1])) {
+        hash ^= Zobrist::enPassant(skipped % BOARD_LENGTH);
+        flipped ^= Zobrist::enPassant(skipped % BOARD_LENGTH);
+    }
+    if (packed.sideToMove() == ChessPiece::WHITE) { hash ^= Zobrist::side(); }
+    else { flipped ^= Zobrist::side(); }
+
+    return std::min(hash, flipped);
+}
+
+/**
+ * @brief Counts an occurrence of a position (thread safe)
+ * @param board A const reference to the position
+ */
+void PositionDedup::add(const ChessBoard& board) {
+    addKey(canonicalKey(board));
+}
+
+/**
+ * @brief Counts an occurrence of a packed position (thread safe)
+ * @param packed A const reference to the position
+ */
+void PositionDedup::add(const PackedPosition& packed) {
+    addKey(canonicalKey(packed));
+}
+
+/**
+ * @brief Counts occurrences of a key (thread safe)
+ * @param key A const reference to the key. 0 is counted as 1, since 0 marks empty slots.
+ * @param count A const reference to the number of occurrences
+ */
+void PositionDedup::addKey(const Zobrist::Key& key, const uint64_t& count) {
+    const Zobrist::Key stored = key != 0 ? key : 1;
+    const size_t index = shardShift_ < 64 ? stored >> shardShift_ : 0;
+    Shard& shard = *shards_[index];
+
+    std::lock_guard<std::mutex> guard(shard.lock);
+    positions_ += count;
+
+    // The top bits chose the shard, so the low bits spread the keys over its slots
+    const size_t mask = shard.entries.size() - 1;
+    for (size_t slot = stored & mask; shard.entries[slot].key != 0; slot = (slot + 1) & mask) {
+        if (shard.entries[slot].key == stored) {
+            shard.entries[slot].count += count;
+            return;
+        }
+    }
+
+    // A new key: keep the table at most 3/4 full
+    if ((shard.used + 1) * 4 > shard.entries.size() * 3) { makeRoom(shard, index); }
+    insert(shard, stored, count);
+}
+
+/**
+ * @brief Adds `count` occurrences of a key to a shard's table
+ * @pre The shard is locked, and its table has a free slot
+ */
+void PositionDedup::insert(Shard& shard, const Zobrist::Key& key, const uint64_t& count) {
+    const size_t mask = shard.entries.size() - 1;
+    size_t slot = key & mask;
+    while (shard.entries[slot].key != 0 && shard.entries[slot].key != key) { slot = (slot + 1) & mask; }
+
+    if (shard.entries[slot].key == 0) {
+        shard.entries[slot].key = key;
+        shard.used++;
+    }
+    shard.entries[slot].count += count;
+}
+
+/**
+ * @brief Doubles the table of a shard, or writes its entries to a new run & empties it once the table is as large as allowed
+ * @pre The shard is locked
+ */
+void PositionDedup::makeRoom(Shard& shard, const size_t& index) {
+    if (shard.entries.size() < maxSlots_ || spillFailed_) {
+        std::vector<Entry> old(shard.entries.size() * 2, Entry{0, 0});
+        old.swap(shard.entries);
+        shard.used = 0;
+        for (const Entry& entry : old) {
+            if (entry.key != 0) { insert(shard, entry.key, entry.count); }
+        }
+        return;
+    }
+
+    const std::string path = options_.spillDirectory + "/dedup-" + std::to_string(getpid()) + "-" + std::to_string(instance_)
+        + "-" + std::to_string(index) + "-" + std::to_string(shard.runs.size()) + ".run";
+    const std::vector<Entry> sorted = sortedEntries(shard);
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(sorted.data()), static_cast<std::streamsize>(sorted.size() * sizeof(Entry)));
+    out.close();
+
+    // Without a run to hold them, the entries stay in memory and the shard grows past its budget
+    if (!out) {
+        std::remove(path.c_str());
+        spillFailed_ = true;
+        makeRoom(shard, index);
+        return;
+    }
+
+    shard.runs.push_back(path);
+    std::fill(shard.entries.begin(), shard.entries.end(), Entry{0, 0});
+    shard.used = 0;
+    spills_++;
+}
+
+/**
+ * @brief Gets the entries of a shard's table, sorted by key
+ * @pre The shard is locked
+ */
+std::vector<PositionDedup::Entry> PositionDedup::sortedEntries(const Shard& shard) {
+    std::vector<Entry> sorted;
+    sorted.reserve(shard.used);
+    for (const Entry& entry : shard.entries) {
+        if (entry.key != 0) { sorted.push_back(entry); }
+    }
+
+    std::sort(sorted.begin(), sorted.end(), [] (const Entry& a, const Entry& b) { return a.key < b.key; });
+    return sorted;
+}
+
+/**
+ * @brief Gets the number of positions added
+ */
+uint64_t PositionDedup::positions() const {
+    return positions_;
+}
+
+/**
+ * @brief Gets the number of runs written to disk
+ */
+uint64_t PositionDedup::spills() const {
+    return spills_;
+}
+
+/**
+ * @brief Visits every distinct key with its total count, in increasing order of key
+ * @pre No thread is adding positions
+ *
+ * @param visitor A const reference to the callback receiving each key (may be empty)
+ * @return The number of distinct keys. Their counts are incomplete if a spill or a run failed to be read (see spillFailed).
+ */
+uint64_t PositionDedup::visit(const Visitor& visitor) {
+    // A sorted sequence of entries: the shard's table, or one of its runs read in place
+    typedef std::pair<const Entry*, const Entry*> Source;
+    auto later = [] (const Source& a, const Source& b) { return a.first->key > b.first->key; };
+
+    uint64_t unique = 0;
+
+    // Shards hold increasing ranges of keys, so merging each in turn keeps the keys in order
+    for (const std::unique_ptr<Shard>& shard : shards_) {
+        std::lock_guard<std::mutex> guard(shard->lock);
+
+        const std::vector<Entry> memory = sortedEntries(*shard);
+        std::vector<std::unique_ptr<MappedFile>> files;
+        std::priority_queue<Source, std::vector<Source>, decltype(later)> sources(later);
+
+        if (!memory.empty()) { sources.push(Source{memory.data(), memory.data() + memory.size()}); }
+        for (const std::string& run : shard->runs) {
+            files.push_back(std::make_unique<MappedFile>(run, true));
+            const MappedFile& file = *files.back();
+            if (!file.isOpen() || file.size() % sizeof(Entry) != 0) {
+                spillFailed_ = true;
+                continue;
+            }
+
+            const Entry* first = reinterpret_cast<const Entry*>(file.data());
+            if (file.size() > 0) { sources.push(Source{first, first + file.size() / sizeof(Entry)}); }
+        }
+
+        // A k-way merge, summing the counts a key has in every source
+        while (!sources.empty()) {
+            const Zobrist::Key key = sources.top().first->key;
+            uint64_t count = 0;
+            while (!sources.empty() && sources.top().first->key == key) {
+                Source source = sources.top();
+                sources.pop();
+                count += source.first->count;
+                if (++source.first != source.second) { sources.push(source); }
+            }
+
+            unique++;
+            if (visitor) { visitor(key, count); }
+        }
+    }
+
+    return unique;
+}
+
+/**
+ * @brief Counts the distinct positions added
+ * @pre No thread is adding positions
+ */
+uint64_t PositionDedup::countUnique() {
+    return visit(Visitor());
+}
+
+/**
+ * @brief Determines whether a run file could not be written or read back. Shards that failed to spill keep growing in memory.
+ */
+bool PositionDedup::spillFailed() const {
+    return spillFailed_;
+}
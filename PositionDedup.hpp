@@ -0,0 +1,190 @@
+/**
+ * @class PositionDedup
+ * @brief Counts the occurrences of each distinct position in a stream of positions, a position and its color flip counting as one.
+ *
+ * The color flip of a position mirrors the board across its horizontal axis (Transform::flipAcrossHorizontal) and swaps
+ * the colors of every piece, the side to move and the castling rights: BLACK's position becomes WHITE's and back. Each
+ * position is reduced to a canonical key, the lower of its Zobrist hash and the hash its color flip would have. The
+ * flipped hash is built from the piece bitboards, so the flipped board is never materialized.
+ *
+ * Keys are counted in a hash set split into shards by their top bits, each behind its own lock, so threads adding
+ * positions rarely wait on each other. A shard that outgrows its share of the memory budget sorts its entries, writes
+ * them to a run file in the spill directory and starts over empty. visit merges the runs of each shard back with what
+ * is still in memory, reading each run sequentially, so the number of distinct positions is not bounded by RAM.
+ *
+ * Two positions with the same 64-bit key are counted as one: with random keys, collisions are negligible below billions of positions.
+ */
+
+#pragma once
+
+#include <mutex>
+#include <memory>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include "ChessBoard.hpp"
+#include "PackedPosition.hpp"
+
+class PositionDedup {
+    public:
+        /**
+         * @brief How to size the set
+         *  - shards: The number of shards, rounded up to a power of 2 (at least 1)
+         *  - memoryMegabytes: The memory the shards may hold before spilling, in MB, split evenly among them
+         *  - spillDirectory: Where the run files are written. They are removed with the set.
+         */
+        struct Options {
+            int shards = 64;
+            size_t memoryMegabytes = 1024;
+            std::string spillDirectory = ".";
+        };
+
+        // Receives each distinct key and its number of occurrences
+        typedef std::function<void(const Zobrist::Key& key, const uint64_t& count)> Visitor;
+
+    private:
+        /**
+         * @brief A counted key. A key of 0 marks an empty slot (see addKey).
+         */
+        struct Entry {
+            Zobrist::Key key;
+            uint64_t count;
+        };
+
+        /**
+         * @brief One lock's worth of the set: an open-addressing table of entries, and the runs it spilled
+         */
+        struct Shard {
+            std::mutex lock;
+            std::vector<Entry> entries;     // A power of 2 of slots, probed linearly from the low bits of the key
+            size_t used = 0;
+            std::vector<std::string> runs;  // Run files, each sorted by key
+        };
+
+        Options options_;
+        std::vector<std::unique_ptr<Shard>> shards_;
+        int shardShift_;                    // Shifts a key right to its shard index
+        size_t maxSlots_;                   // The most slots a shard grows to before it spills
+        std::atomic<uint64_t> positions_;
+        std::atomic<uint64_t> spills_;
+        std::atomic<bool> spillFailed_;
+
+        // Tells the run files of each set apart
+        static std::atomic<uint64_t> instances_;
+        uint64_t instance_;
+
+        /**
+         * @brief Adds `count` occurrences of a key to a shard's table
+         * @pre The shard is locked, and its table has a free slot
+         */
+        static void insert(Shard& shard, const Zobrist::Key& key, const uint64_t& count);
+
+        /**
+         * @brief Doubles the table of a shard, or writes its entries to a new run & empties it once the table is as large as allowed
+         * @pre The shard is locked
+         */
+        void makeRoom(Shard& shard, const size_t& index);
+
+        /**
+         * @brief Gets the entries of a shard's table, sorted by key
+         * @pre The shard is locked
+         */
+        static std::vector<Entry> sortedEntries(const Shard& shard);
+
+    public:
+        /**
+         * @brief Constructs an empty set with the default Options
+         */
+        PositionDedup();
+
+        /**
+         * @brief Constructs an empty set
+         * @param options A const reference to the Options of the set
+         */
+        explicit PositionDedup(const Options& options);
+
+        /**
+         * @brief Destructor. Removes the run files.
+         */
+        ~PositionDedup();
+
+        PositionDedup(const PositionDedup&) = delete;
+        PositionDedup& operator=(const PositionDedup&) = delete;
+
+        /**
+         * @brief Computes the Zobrist hash the color flip of a position would have, without building it
+         * @param board A const reference to the position
+         * @return The hash of the flipped position, as ChessBoard::getHash would give it
+         */
+        static Zobrist::Key colorFlippedHash(const ChessBoard& board);
+
+        /**
+         * @brief Computes the key shared by a position and its color flip
+         * @param board A const reference to the position
+         * @return The lower of the position's hash and of its color flip's hash
+         */
+        static Zobrist::Key canonicalKey(const ChessBoard& board);
+
+        /**
+         * @brief Computes the key shared by a position and its color flip, in one pass over a packed position (without unpacking it)
+         *
+         * The castling rights & en passant square are read as setFromPacked reads them: a right whose king or rook is not
+         * home, and an en passant square no pawn can capture onto, are dropped before hashing.
+         *
+         * @param packed A const reference to the position
+         * @return The same key as canonicalKey of the board setFromPacked unpacks the position to. Records setFromPacked 
+         *      rejects still get a key, from their pieces & the fields that pass the rules above.
+         */
+        static Zobrist::Key canonicalKey(const PackedPosition& packed);
+
+        /**
+         * @brief Counts an occurrence of a position (thread safe)
+         * @param board A const reference to the position
+         */
+        void add(const ChessBoard& board);
+
+        /**
+         * @brief Counts an occurrence of a packed position (thread safe)
+         * @param packed A const reference to the position
+         */
+        void add(const PackedPosition& packed);
+
+        /**
+         * @brief Counts occurrences of a key (thread safe)
+         * @param key A const reference to the key. 0 is counted as 1, since 0 marks empty slots.
+         * @param count A const reference to the number of occurrences
+         */
+        void addKey(const Zobrist::Key& key, const uint64_t& count = 1);
+
+        /**
+         * @brief Gets the number of positions added
+         */
+        uint64_t positions() const;
+
+        /**
+         * @brief Gets the number of runs written to disk
+         */
+        uint64_t spills() const;
+
+        /**
+         * @brief Visits every distinct key with its total count, in increasing order of key
+         * @pre No thread is adding positions
+         *
+         * @param visitor A const reference to the callback receiving each key (may be empty)
+         * @return The number of distinct keys. Their counts are incomplete if a spill or a run failed to be read (see spillFailed).
+         */
+        uint64_t visit(const Visitor& visitor);
+
+        /**
+         * @brief Counts the distinct positions added
+         * @pre No thread is adding positions
+         */
+        uint64_t countUnique();
+
+        /**
+         * @brief Determines whether a run file could not be written or read back. Shards that failed to spill keep growing in memory.
+         */
+        bool spillFailed() const;
+};
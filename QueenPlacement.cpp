@@ -0,0 +1,104 @@
+#include "QueenPlacement.hpp"
+#include <algorithm>
+
+/**
+ * @brief Default constructor. 
+ * @post The placement has no columns.
+ */
+QueenPlacement::QueenPlacement() : rows_{}, length_{0} {}
+
+/**
+ * @brief Constructs a placement for an n x n board
+ * @param n A const reference to the number of columns. Clamped to [0, MAX_LENGTH].
+ * @post Every column holds its queen on row 0.
+ */
+QueenPlacement::QueenPlacement(const int& n) : rows_{}, length_{ static_cast<uint8_t>(std::clamp(n, 0, MAX_LENGTH)) } {}
+
+/**
+ * @brief Reads the placement drawn on a board.
+ * 
+ * @param board A const reference to a square CharacterBoard, where empty cells are '*'
+ * @return The placement holding, for each column, the row of its first non-'*' cell (row 0 if the column is empty)
+ */
+QueenPlacement QueenPlacement::fromCharacterBoard(const CharacterBoard& board) {
+    QueenPlacement placement(board.size());
+
+    for (int col = 0; col < placement.size(); col++) {
+        for (int row = 0; row < placement.size(); row++) {
+            if (board[row][col] != '*') {
+                placement.setRow(col, row);
+                break;
+            }
+        }
+    }
+
+    return placement;
+}
+
+/**
+ * @brief Gets the number of columns of the placement
+ * @return The value stored in length_
+ */
+int QueenPlacement::size() const {
+    return length_;
+}
+
+/**
+ * @brief Gets the row of the queen in a column
+ * @param col A const reference to a column in [0, size())
+ * @return The row of the queen in column col
+ */
+int QueenPlacement::operator[](const int& col) const {
+    return rows_[col];
+}
+
+/**
+ * @brief Sets the row of the queen in a column
+ * @param col A const reference to a column in [0, size())
+ * @param row A const reference to a row in [0, size())
+ */
+void QueenPlacement::setRow(const int& col, const int& row) {
+    rows_[col] = row;
+}
+
+/**
+ * @brief Builds the display form of the placement
+ * @return A size() x size() CharacterBoard with 'Q' on every queen and '*' on every other cell
+ */
+QueenPlacement::CharacterBoard QueenPlacement::toCharacterBoard() const {
+    CharacterBoard board(length_, std::vector<char>(length_, '*'));
+    for (int col = 0; col < length_; col++) {
+        board[rows_[col]][col] = 'Q';
+    }
+
+    return board;
+}
+
+/**
+ * @brief Compares placements column by column.
+ * @note Shorter placements come first. Placements of the same size are ordered the way the queen searches find them.
+ */
+bool QueenPlacement::operator<(const QueenPlacement& other) const {
+    if (length_ != other.length_) { return length_ < other.length_; }
+    return std::lexicographical_compare(rows_.begin(), rows_.begin() + length_, other.rows_.begin(), other.rows_.begin() + length_);
+}
+
+bool QueenPlacement::operator==(const QueenPlacement& other) const {
+    return length_ == other.length_ && std::equal(rows_.begin(), rows_.begin() + length_, other.rows_.begin());
+}
+
+bool QueenPlacement::operator!=(const QueenPlacement& other) const {
+    return !(*this == other);
+}
+
+/**
+ * @brief Hashes the rows of a placement (FNV-1a)
+ */
+size_t QueenPlacement::Hash::operator()(const QueenPlacement& placement) const {
+    uint64_t hash = 14695981039346656037ull;
+    for (int col = 0; col < placement.size(); col++) {
+        hash = (hash ^ placement[col]) * 1099511628211ull;
+    }
+
+    return hash;
+}
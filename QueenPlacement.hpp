@@ -0,0 +1,89 @@
+/**
+ * @class QueenPlacement
+ * @brief A compact solution to the n-queens problem: the row of the queen in each column.
+ * 
+ * Since a solution holds exactly one queen per column, it is fully described by 
+ * one byte per column, stored inline (no heap allocation). The CharacterBoard form 
+ * is only built when it is requested for display.
+ */
+
+#pragma once
+
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+class QueenPlacement {
+    public:
+        // The largest number of columns a placement can hold
+        static constexpr int MAX_LENGTH = 27;
+
+        // Alias for readability
+        typedef std::vector<std::vector<char>> CharacterBoard;
+
+        // Hashes a placement, so placements can key unordered containers
+        struct Hash {
+            size_t operator()(const QueenPlacement& placement) const;
+        };
+
+    private:
+        std::array<uint8_t, MAX_LENGTH> rows_;  // rows_[col] is the row of the queen in column col
+        uint8_t length_;                        // The number of columns (and rows) of the board
+
+    public:
+        /**
+         * @brief Default constructor. 
+         * @post The placement has no columns.
+         */
+        QueenPlacement();
+
+        /**
+         * @brief Constructs a placement for an n x n board
+         * @param n A const reference to the number of columns. Clamped to [0, MAX_LENGTH].
+         * @post Every column holds its queen on row 0.
+         */
+        QueenPlacement(const int& n);
+
+        /**
+         * @brief Reads the placement drawn on a board.
+         * 
+         * @param board A const reference to a square CharacterBoard, where empty cells are '*'
+         * @return The placement holding, for each column, the row of its first non-'*' cell (row 0 if the column is empty)
+         */
+        static QueenPlacement fromCharacterBoard(const CharacterBoard& board);
+
+        /**
+         * @brief Gets the number of columns of the placement
+         * @return The value stored in length_
+         */
+        int size() const;
+
+        /**
+         * @brief Gets the row of the queen in a column
+         * @param col A const reference to a column in [0, size())
+         * @return The row of the queen in column col
+         */
+        int operator[](const int& col) const;
+
+        /**
+         * @brief Sets the row of the queen in a column
+         * @param col A const reference to a column in [0, size())
+         * @param row A const reference to a row in [0, size())
+         */
+        void setRow(const int& col, const int& row);
+
+        /**
+         * @brief Builds the display form of the placement
+         * @return A size() x size() CharacterBoard with 'Q' on every queen and '*' on every other cell
+         */
+        CharacterBoard toCharacterBoard() const;
+
+        /**
+         * @brief Compares placements column by column.
+         * @note Shorter placements come first. Placements of the same size are ordered the way the queen searches find them.
+         */
+        bool operator<(const QueenPlacement& other) const;
+        bool operator==(const QueenPlacement& other) const;
+        bool operator!=(const QueenPlacement& other) const;
+};
@@ -0,0 +1,416 @@
+#include "Search.hpp"
+#include "WorkStealingPool.hpp"
+#include <algorithm>
+
+namespace {
+    // Move ordering bands, from first to last searched
+    constexpr int TT_MOVE_ORDER = 1000000;
+    constexpr int CAPTURE_ORDER = 100000;
+    constexpr int PROMOTION_ORDER = 90000;
+    constexpr int KILLER_ORDER = 80000;
+    constexpr int HISTORY_LIMIT = 70000;
+
+    // The half-width of the first aspiration window, in centipawns
+    constexpr int ASPIRATION_WINDOW = 25;
+
+    /**
+     * @brief Gets the material a piece puts at stake when it captures, for ordering captures
+     * @return The material the evaluation counts for the type. The king, which the evaluation never counts,
+     *      ranks above the queen, so it captures last.
+     */
+    int attackerMaterial(const PieceType& type) {
+        return type == PieceType::KING ? 1000 : PieceSquare::detail::MATERIAL[static_cast<int>(type)];
+    }
+
+    /**
+     * @brief Converts a mate score from "plies from this position" (as stored) to "plies from the root" (as searched), and back
+     */
+    int toTable(const int& score, const int& ply) {
+        if (score >= Search::MATE_BOUND) { return score + ply; }
+        if (score <= -Search::MATE_BOUND) { return score - ply; }
+        return score;
+    }
+
+    int fromTable(const int& score, const int& ply) {
+        if (score >= Search::MATE_BOUND) { return score - ply; }
+        if (score <= -Search::MATE_BOUND) { return score + ply; }
+        return score;
+    }
+};
+
+/**
+ * @brief Formats a score for display
+ * @param score A const reference to a score
+ * @return "cp <centipawns>", or "mate <moves>" (negative when the side to move is mated)
+ */
+std::string Search::scoreToString(const int& score) {
+    if (score >= MATE_BOUND) { return "mate " + std::to_string((MATE_SCORE - score + 1) / 2); }
+    if (score <= -MATE_BOUND) { return "mate -" + std::to_string((MATE_SCORE + score) / 2); }
+    return "cp " + std::to_string(score);
+}
+
+/**
+ * @brief Builds the state of a searching thread, with empty killers, history & pawn structure cache
+ */
+Search::Worker::Worker(const int& id, const ChessBoard& board, const size_t& pawnCacheKilobytes)
+ : id{id}, board{board}, nodes{0}, path{}, pv{}, pvLength{}, killers{}, history{}, evaluator{pawnCacheKilobytes} {}
+
+/**
+ * @brief Constructs a search
+ * @param table A (non-const) reference to the TranspositionTable the threads share. It must outlive the search.
+ */
+Search::Search(TranspositionTable& table) : table_{table}, stop_{false}, limits_{}, start_{}, workers_{} {}
+
+/**
+ * @brief Searches a position until a limit is reached
+ * @return The Info of the last completed iteration. Its pv is empty if the side to move has no legal move.
+ */
+Search::Info Search::run(const ChessBoard& board, const Limits& limits) {
+    return run(board, limits, InfoCallback());
+}
+
+/**
+ * @brief Searches a position until a limit is reached
+ *
+ * @param board A const reference to the position to search (it is copied, never changed)
+ * @param limits A const reference to the Limits of the search
+ * @param onIteration A const reference to a callback receiving the Info of every completed iteration (may be empty)
+ * @return The Info of the last completed iteration. Its pv is empty if the side to move has no legal move.
+ */
+Search::Info Search::run(const ChessBoard& board, const Limits& limits, const InfoCallback& onIteration) {
+    // Build the attack tables before the clock starts
+    Attacks::init();
+
+    limits_ = limits;
+    limits_.depth = std::clamp(limits_.depth, 1, MAX_PLY - 1);
+    start_ = std::chrono::steady_clock::now();
+    stop_ = false;
+    table_.newSearch();
+
+    Info info{0, 0, 0, 0, 0, 0, {}};
+
+    // Without a legal move there is nothing to search: the side to move is mated or stalemated
+    MoveList moves;
+    board.generateLegalMoves(moves);
+    if (moves.empty()) {
+        info.score = board.isInCheck() ? -MATE_SCORE : 0;
+        return info;
+    }
+
+    WorkStealingPool pool(limits_.threads);
+
+    workers_.clear();
+    std::vector<WorkStealingPool::Task> tasks;
+    for (int id = 0; id < pool.size(); id++) {
+        workers_.push_back(std::unique_ptr<Worker>(new Worker(id, board, limits_.pawnCacheKilobytes)));
+        tasks.push_back([this, id, &info, &onIteration] (const int&) { iterate(*workers_[id], info, onIteration); });
+    }
+    pool.run(tasks);
+
+    // Stopped before the first iteration completed: any legal move beats none
+    if (info.pv.empty()) { info.pv.push_back(moves[0]); }
+
+    workers_.clear();
+    return info;
+}
+
+/**
+ * @brief Asks a running search to stop (safe to call from any thread). run returns the last completed iteration.
+ */
+void Search::stop() {
+    stop_ = true;
+}
+
+/**
+ * @brief Runs the iterative deepening of one thread
+ *
+ * @param worker A (non-const) reference to the Worker of the thread
+ * @param info A (non-const) reference to the Info of the last iteration completed (only written by thread 0)
+ * @param onIteration A const reference to the callback receiving each Info of thread 0 (may be empty)
+ */
+void Search::iterate(Worker& worker, Info& info, const InfoCallback& onIteration) {
+    int score = 0;
+
+    // Helpers start one ply deeper on odd threads, so they search ahead of thread 0 instead of beside it
+    for (int depth = 1 + (worker.id % 2); depth <= limits_.depth && !stop_.load(std::memory_order_relaxed); depth++) {
+        int delta = ASPIRATION_WINDOW;
+        int alpha = -INFINITE_SCORE;
+        int beta = INFINITE_SCORE;
+        if (depth >= 4) {
+            alpha = std::max(score - delta, -INFINITE_SCORE);
+            beta = std::min(score + delta, INFINITE_SCORE);
+        }
+
+        // Widen the window on the side the score fell out of, until the score lands inside it
+        while (true) {
+            int result = negamax(worker, depth, alpha, beta, 0);
+            if (stop_.load(std::memory_order_relaxed)) { break; }
+
+            if (result <= alpha) {
+                alpha = std::max(result - delta, -INFINITE_SCORE);
+            } else if (result >= beta) {
+                beta = std::min(result + delta, INFINITE_SCORE);
+            } else {
+                score = result;
+                break;
+            }
+
+            delta *= 2;
+        }
+
+        if (stop_.load(std::memory_order_relaxed) || worker.id != 0) { continue; }
+
+        info.depth = depth;
+        info.score = score;
+        info.nodes = totalNodes();
+        info.milliseconds = elapsedMilliseconds();
+        info.nodesPerSecond = info.nodes * 1000 / static_cast<uint64_t>(std::max<int64_t>(info.milliseconds, 1));
+        info.hashfull = table_.hashfull();
+        info.pv.assign(worker.pv[0].begin(), worker.pv[0].begin() + worker.pvLength[0]);
+
+        if (onIteration) { onIteration(info); }
+    }
+
+    // The helpers only help thread 0, so they stop with it
+    if (worker.id == 0) { stop_ = true; }
+}
+
+/**
+ * @brief Searches a position to a fixed depth
+ *
+ * @param worker A (non-const) reference to the Worker searching
+ * @param depth The number of plies left before the quiescence search
+ * @param alpha The score the side to move is already guaranteed
+ * @param beta The score the opponent is already guaranteed (the side to move cannot get more)
+ * @param ply A const reference to the distance from the root
+ * @return The score of the position, exact if within (alpha, beta). 0 if the search was stopped.
+ */
+int Search::negamax(Worker& worker, int depth, int alpha, int beta, const int& ply) {
+    ChessBoard& board = worker.board;
+    worker.pvLength[ply] = ply;
+
+    // Look one ply further when in check, so checks at the horizon are not mistaken for quiet positions
+    const bool inCheck = board.isInCheck();
+    if (inCheck) { depth++; }
+
+    if (depth <= 0) { return quiescence(worker, alpha, beta, ply); }
+    if (countNode(worker)) { return 0; }
+
+    const Zobrist::Key hash = board.getHash();
+    const bool pvNode = beta - alpha > 1;
+    worker.path[ply] = hash;
+
+    if (ply > 0) {
+        // A position repeated along the line is a draw
+        for (int previous = ply - 2; previous >= 0; previous -= 2) {
+            if (worker.path[previous] == hash) { return 0; }
+        }
+
+        if (ply >= MAX_PLY - 1) { return worker.evaluator.evaluate(board); }
+    }
+
+    Move ttMove = Move::none();
+    TranspositionTable::Data entry;
+    if (table_.probe(hash, entry)) {
+        ttMove = entry.move;
+
+        if (!pvNode && entry.depth >= depth) {
+            int score = fromTable(entry.score, ply);
+            if (entry.bound == TranspositionTable::EXACT ||
+                (entry.bound == TranspositionTable::LOWER && score >= beta) ||
+                (entry.bound == TranspositionTable::UPPER && score <= alpha)) { return score; }
+        }
+    }
+
+    MoveList moves;
+    board.generateLegalMoves(moves);
+    if (moves.empty()) { return inCheck ? -MATE_SCORE + ply : 0; }
+
+    std::array<int, MoveList::CAPACITY> scores;
+    scoreMoves(worker, moves, ttMove, ply, scores);
+
+    const int originalAlpha = alpha;
+    int best = -INFINITE_SCORE;
+    Move bestMove = Move::none();
+
+    for (int i = 0; i < moves.size(); i++) {
+        Move move = pickMove(moves, scores, i);
+
+        // Principal variation search: the first move gets the full window, the others a null window to prove they are worse
+        ChessBoard::UndoRecord undo = board.makeMove(move);
+        int score;
+        if (i == 0) {
+            score = -negamax(worker, depth - 1, -beta, -alpha, ply + 1);
+        } else {
+            score = -negamax(worker, depth - 1, -alpha - 1, -alpha, ply + 1);
+            if (score > alpha && score < beta) { score = -negamax(worker, depth - 1, -beta, -alpha, ply + 1); }
+        }
+        board.unmakeMove(undo);
+
+        if (stop_.load(std::memory_order_relaxed)) { return 0; }
+        if (score <= best) { continue; }
+
+        best = score;
+        bestMove = move;
+        if (score <= alpha) { continue; }
+
+        alpha = score;
+        worker.pv[ply][ply] = move;
+        for (int next = ply + 1; next < worker.pvLength[ply + 1]; next++) { worker.pv[ply][next] = worker.pv[ply + 1][next]; }
+        worker.pvLength[ply] = std::max(worker.pvLength[ply + 1], ply + 1);
+
+        if (alpha >= beta) {
+            if (!move.isCapture() && !move.isPromotion()) {
+                if (worker.killers[ply][0] != move) {
+                    worker.killers[ply][1] = worker.killers[ply][0];
+                    worker.killers[ply][0] = move;
+                }
+
+                int& history = worker.history[move.from()][move.to()];
+                history = std::min(history + depth * depth, HISTORY_LIMIT);
+            }
+            break;
+        }
+    }
+
+    TranspositionTable::Bound bound = best >= beta ? TranspositionTable::LOWER :
+        (best > originalAlpha ? TranspositionTable::EXACT : TranspositionTable::UPPER);
+    // Interior nodes never evaluate the position statically, so there is no eval to store
+    table_.store(hash, bestMove, toTable(best, ply), TranspositionTable::NO_EVAL, depth, bound);
+
+    return best;
+}
+
+/**
+ * @brief Searches the captures & promotions of a position until it is quiet (every move, when in check)
+ * @return The score of the position, exact if within (alpha, beta). 0 if the search was stopped.
+ */
+int Search::quiescence(Worker& worker, int alpha, int beta, const int& ply) {
+    ChessBoard& board = worker.board;
+    worker.pvLength[ply] = ply;
+
+    if (countNode(worker)) { return 0; }
+    if (ply >= MAX_PLY - 1) { return worker.evaluator.evaluate(board); }
+
+    // Out of check, the side to move may "stand pat": decline every capture and keep the static evaluation
+    const bool inCheck = board.isInCheck();
+    int best = -INFINITE_SCORE;
+    if (!inCheck) {
+        best = worker.evaluator.evaluate(board);
+        if (best >= beta) { return best; }
+        alpha = std::max(alpha, best);
+    }
+
+    MoveList moves;
+    board.generateLegalMoves(moves);
+    if (inCheck && moves.empty()) { return -MATE_SCORE + ply; }
+
+    std::array<int, MoveList::CAPACITY> scores;
+    scoreMoves(worker, moves, Move::none(), ply, scores);
+
+    for (int i = 0; i < moves.size(); i++) {
+        Move move = pickMove(moves, scores, i);
+        if (!inCheck && !move.isCapture() && !move.isPromotion()) { break; }     // Ordered last: only quiet moves are left
+
+        ChessBoard::UndoRecord undo = board.makeMove(move);
+        int score = -quiescence(worker, -beta, -alpha, ply + 1);
+        board.unmakeMove(undo);
+
+        if (stop_.load(std::memory_order_relaxed)) { return 0; }
+        if (score <= best) { continue; }
+
+        best = score;
+        if (score <= alpha) { continue; }
+
+        alpha = score;
+        worker.pv[ply][ply] = move;
+        for (int next = ply + 1; next < worker.pvLength[ply + 1]; next++) { worker.pv[ply][next] = worker.pv[ply + 1][next]; }
+        worker.pvLength[ply] = std::max(worker.pvLength[ply + 1], ply + 1);
+
+        if (alpha >= beta) { break; }
+    }
+
+    return best;
+}
+
+/**
+ * @brief Scores moves for ordering: the table move, then captures (most valuable victim, least valuable attacker),
+ *      promotions, killer moves, and quiet moves by history
+ *
+ * @param worker A const reference to the Worker searching
+ * @param moves A const reference to the moves to score
+ * @param ttMove A const reference to the move stored in the table for the position, Move::none() if there is none
+ * @param ply A const reference to the distance from the root
+ * @param scores A (non-const) reference receiving the score of each move, by index
+ */
+void Search::scoreMoves(const Worker& worker, const MoveList& moves, const Move& ttMove, const int& ply, std::array<int, MoveList::CAPACITY>& scores) {
+    const Mailbox& mailbox = worker.board.getMailbox();
+
+    for (int i = 0; i < moves.size(); i++) {
+        const Move& move = moves[i];
+
+        if (move == ttMove) {
+            scores[i] = TT_MOVE_ORDER;
+        } else if (move.isCapture()) {
+            PieceType victim = move.isEnPassant() ? PieceType::PAWN : static_cast<PieceType>(Mailbox::typeOf(mailbox[move.to()]));
+            PieceType attacker = static_cast<PieceType>(Mailbox::typeOf(mailbox[move.from()]));
+            int promotion = move.isPromotion() ? PieceSquare::detail::MATERIAL[static_cast<int>(move.promotionType())] : 0;
+
+            // Scaled so the victim decides first: 10 * victim grows by at least 100 between types, the attacker term spans 10 to 100
+            scores[i] = CAPTURE_ORDER + 10 * PieceSquare::detail::MATERIAL[static_cast<int>(victim)] - attackerMaterial(attacker) / 10 + promotion;
+        } else if (move.isPromotion()) {
+            scores[i] = PROMOTION_ORDER + PieceSquare::detail::MATERIAL[static_cast<int>(move.promotionType())];
+        } else if (move == worker.killers[ply][0]) {
+            scores[i] = KILLER_ORDER;
+        } else if (move == worker.killers[ply][1]) {
+            scores[i] = KILLER_ORDER - 1;
+        } else {
+            scores[i] = worker.history[move.from()][move.to()];
+        }
+    }
+}
+
+/**
+ * @brief Moves the best scored of the moves from `index` on to `index` (one step of a selection sort)
+ * @return The move now at `index`
+ */
+Move Search::pickMove(MoveList& moves, std::array<int, MoveList::CAPACITY>& scores, const int& index) {
+    int best = index;
+    for (int i = index + 1; i < moves.size(); i++) {
+        if (scores[i] > scores[best]) { best = i; }
+    }
+
+    std::swap(moves[index], moves[best]);
+    std::swap(scores[index], scores[best]);
+    return moves[index];
+}
+
+/**
+ * @brief Counts a node & checks whether the search must stop. Thread 0 checks the clock every 2048 nodes.
+ * @return True if the search must stop
+ */
+bool Search::countNode(Worker& worker) {
+    uint64_t nodes = worker.nodes.load(std::memory_order_relaxed) + 1;
+    worker.nodes.store(nodes, std::memory_order_relaxed);
+
+    if (worker.id == 0 && (nodes & 2047) == 0 && limits_.milliseconds > 0 && elapsedMilliseconds() >= limits_.milliseconds) { stop_ = true; }
+
+    return stop_.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Gets the nodes searched so far by every thread
+ */
+uint64_t Search::totalNodes() const {
+    uint64_t nodes = 0;
+    for (const std::unique_ptr<Worker>& worker : workers_) { nodes += worker->nodes.load(std::memory_order_relaxed); }
+
+    return nodes;
+}
+
+/**
+ * @brief Gets the time spent since the search started
+ */
+int64_t Search::elapsedMilliseconds() const {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start_).count();
+}
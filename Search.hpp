@@ -0,0 +1,189 @@
+/**
+ * @class Search
+ * @brief Finds the best move of a ChessBoard with a negamax alpha-beta search.
+ *
+ * Each thread runs its own iterative deepening on its own copy of the board (Lazy SMP). The threads share
+ * nothing but the TranspositionTable, so what one thread learns about a position cuts the search of the
+ * others. Thread 0 owns the clock and the reported results. The other threads start at alternating depths,
+ * so they fill the table ahead of it.
+ *
+ * Every iteration searches with principal variation search inside an aspiration window around the score
+ * of the previous iteration, and resolves captures at the leaves with a quiescence search. The leaves are
+ * scored by an Evaluator.
+ *
+ * Scores are in centipawns from the side to move's point of view. A mate in n plies scores MATE_SCORE - n.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include "ChessBoard.hpp"
+#include "TranspositionTable.hpp"
+#include "Evaluator.hpp"
+
+class Search {
+    public:
+        // The deepest line the search follows, quiescence included
+        static constexpr int MAX_PLY = 128;
+
+        // Scores
+        static constexpr int INFINITE_SCORE = 32001;
+        static constexpr int MATE_SCORE = 32000;
+        static constexpr int MATE_BOUND = MATE_SCORE - MAX_PLY;     // Scores beyond +-MATE_BOUND are mates
+
+        /**
+         * @brief When to stop searching
+         *  - depth: The last iteration to search, in [1, MAX_PLY)
+         *  - milliseconds: The time budget, 0 for none
+         *  - threads: The number of threads searching. If not positive, the hardware concurrency is used.
+         *  - pawnCacheKilobytes: The size of each thread's pawn structure cache (see Evaluator), 0 for none
+         */
+        struct Limits {
+            int depth = MAX_PLY - 1;
+            int64_t milliseconds = 0;
+            int threads = 1;
+            size_t pawnCacheKilobytes = Evaluator::DEFAULT_PAWN_CACHE_KILOBYTES;
+        };
+
+        /**
+         * @brief The state of the search after an iteration
+         */
+        struct Info {
+            int depth;
+            int score;
+            uint64_t nodes;             // Summed over every thread
+            int64_t milliseconds;
+            uint64_t nodesPerSecond;
+            int hashfull;               // The permille of the table filled by this search
+            std::vector<Move> pv;       // The principal variation, best move first
+        };
+
+        // Receives the Info of every iteration completed by thread 0
+        typedef std::function<void(const Info&)> InfoCallback;
+
+        /**
+         * @brief Formats a score for display
+         * @param score A const reference to a score
+         * @return "cp <centipawns>", or "mate <moves>" (negative when the side to move is mated)
+         */
+        static std::string scoreToString(const int& score);
+
+    private:
+        /**
+         * @brief The private state of one searching thread
+         */
+        struct Worker {
+            int id;
+            ChessBoard board;
+            std::atomic<uint64_t> nodes;                                    // Only written by its own thread
+            std::array<Zobrist::Key, MAX_PLY + 1> path;                     // path[ply] is the hash of the position at that ply
+            std::array<std::array<Move, MAX_PLY + 1>, MAX_PLY + 1> pv;      // pv[ply][ply, pvLength[ply]) is the best line found from ply
+            std::array<int, MAX_PLY + 1> pvLength;
+            std::array<std::array<Move, 2>, MAX_PLY + 1> killers;           // Quiet moves that caused a cutoff at each ply
+            std::array<std::array<int, 64>, 64> history;                    // history[from][to] grows with the cutoffs of a quiet move
+            Evaluator evaluator;                                            // Scores the leaves, with a pawn structure cache of its own
+
+            Worker(const int& id, const ChessBoard& board, const size_t& pawnCacheKilobytes);
+        };
+
+        TranspositionTable& table_;
+        std::atomic<bool> stop_;
+        Limits limits_;
+        std::chrono::steady_clock::time_point start_;
+        std::vector<std::unique_ptr<Worker>> workers_;
+
+        /**
+         * @brief Runs the iterative deepening of one thread
+         *
+         * @param worker A (non-const) reference to the Worker of the thread
+         * @param info A (non-const) reference to the Info of the last iteration completed (only written by thread 0)
+         * @param onIteration A const reference to the callback receiving each Info of thread 0 (may be empty)
+         */
+        void iterate(Worker& worker, Info& info, const InfoCallback& onIteration);
+
+        /**
+         * @brief Searches a position to a fixed depth
+         *
+         * @param worker A (non-const) reference to the Worker searching
+         * @param depth The number of plies left before the quiescence search
+         * @param alpha The score the side to move is already guaranteed
+         * @param beta The score the opponent is already guaranteed (the side to move cannot get more)
+         * @param ply A const reference to the distance from the root
+         * @return The score of the position, exact if within (alpha, beta). 0 if the search was stopped.
+         */
+        int negamax(Worker& worker, int depth, int alpha, int beta, const int& ply);
+
+        /**
+         * @brief Searches the captures & promotions of a position until it is quiet (every move, when in check)
+         * @return The score of the position, exact if within (alpha, beta). 0 if the search was stopped.
+         */
+        int quiescence(Worker& worker, int alpha, int beta, const int& ply);
+
+        /**
+         * @brief Scores moves for ordering: the table move, then captures (most valuable victim, least valuable attacker),
+         *      promotions, killer moves, and quiet moves by history
+         *
+         * @param worker A const reference to the Worker searching
+         * @param moves A const reference to the moves to score
+         * @param ttMove A const reference to the move stored in the table for the position, Move::none() if there is none
+         * @param ply A const reference to the distance from the root
+         * @param scores A (non-const) reference receiving the score of each move, by index
+         */
+        static void scoreMoves(const Worker& worker, const MoveList& moves, const Move& ttMove, const int& ply, std::array<int, MoveList::CAPACITY>& scores);
+
+        /**
+         * @brief Moves the best scored of the moves from `index` on to `index` (one step of a selection sort)
+         * @return The move now at `index`
+         */
+        static Move pickMove(MoveList& moves, std::array<int, MoveList::CAPACITY>& scores, const int& index);
+
+        /**
+         * @brief Counts a node & checks whether the search must stop. Thread 0 checks the clock every 2048 nodes.
+         * @return True if the search must stop
+         */
+        bool countNode(Worker& worker);
+
+        /**
+         * @brief Gets the nodes searched so far by every thread
+         */
+        uint64_t totalNodes() const;
+
+        /**
+         * @brief Gets the time spent since the search started
+         */
+        int64_t elapsedMilliseconds() const;
+
+    public:
+        /**
+         * @brief Constructs a search
+         * @param table A (non-const) reference to the TranspositionTable the threads share. It must outlive the search.
+         */
+        explicit Search(TranspositionTable& table);
+
+        /**
+         * @brief Searches a position until a limit is reached
+         *
+         * @param board A const reference to the position to search (it is copied, never changed)
+         * @param limits A const reference to the Limits of the search
+         * @param onIteration A const reference to a callback receiving the Info of every completed iteration (may be empty)
+         * @return The Info of the last completed iteration. Its pv is empty if the side to move has no legal move.
+         */
+        Info run(const ChessBoard& board, const Limits& limits, const InfoCallback& onIteration);
+
+        /**
+         * @brief Searches a position until a limit is reached
+         * @return The Info of the last completed iteration. Its pv is empty if the side to move has no legal move.
+         */
+        Info run(const ChessBoard& board, const Limits& limits);
+
+        /**
+         * @brief Asks a running search to stop (safe to call from any thread). run returns the last completed iteration.
+         */
+        void stop();
+};
@@ -69,4 +69,702 @@ std::vector<std::vector<T>> Transform::flipAcrossHorizontal(const std::vector<st
     }
 
     return result;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Rotates a fixed-size square matrix 90 degrees clockwise.
+ * @note The size is known at compile time, so the loops can be fully unrolled and nothing is heap-allocated.
+ * 
+ * @param matrix A const reference to an N x N array of objects of type T
+ * @return A new array representing the rotated matrix
+ */
+template <typename T, size_t N>
+std::array<std::array<T, N>, N> Transform::rotate(const std::array<std::array<T, N>, N>& matrix) {
+    std::array<std::array<T, N>, N> result;
+
+    for (size_t i = 0; i < N; i++) {
+        for (size_t j = 0; j < N; j++) {
+            result[i][j] = matrix[N - 1 - j][i];
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Swaps the elements of a fixed-size square matrix across its vertical axis of symmetry
+ * 
+ * @param matrix A const reference to an N x N array of objects of type T
+ * @return A new array representing the transformed matrix
+ */
+template <typename T, size_t N>
+std::array<std::array<T, N>, N> Transform::flipAcrossVertical(const std::array<std::array<T, N>, N>& matrix) {
+    std::array<std::array<T, N>, N> result;
+
+    for (size_t i = 0; i < N; i++) {
+        for (size_t j = 0; j < N; j++) {
+            result[i][j] = matrix[i][N - 1 - j];
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Swaps the elements of a fixed-size square matrix across its horizontal axis of symmetry
+ * 
+ * @param matrix A const reference to an N x N array of objects of type T
+ * @return A new array representing the transformed matrix
+ */
+template <typename T, size_t N>
+std::array<std::array<T, N>, N> Transform::flipAcrossHorizontal(const std::array<std::array<T, N>, N>& matrix) {
+    std::array<std::array<T, N>, N> result;
+
+    for (size_t i = 0; i < N; i++) {
+        result[i] = matrix[N - 1 - i];
+    }
+
+    return result;
+}
+
+/**
+ * @brief Rotates a square matrix 90 degrees clockwise, in place.
+ * @pre The matrix must be square 
+ * 
+ * @param matrix A (non-const) reference to a square matrix (a 2D vector or an N x N array)
+ */
+template <typename Matrix>
+void Transform::rotateInPlace(Matrix& matrix) {
+    int n = matrix.size();
+
+    for (int i = 0; i < n; i++) {
+        for (int j = i + 1; j < n; j++) {
+            std::swap(matrix[i][j], matrix[j][i]);
+        }
+    }
+
+    for (int i = 0; i < n; i++) {
+        std::reverse(matrix[i].begin(), matrix[i].end());
+    }
+}
+
+/**
+ * @brief Swaps the elements of a square matrix across its vertical axis of symmetry, in place.
+ * @pre The matrix must be square 
+ * 
+ * @param matrix A (non-const) reference to a square matrix (a 2D vector or an N x N array)
+ */
+template <typename Matrix>
+void Transform::flipAcrossVerticalInPlace(Matrix& matrix) {
+    for (auto& row : matrix) {
+        std::reverse(row.begin(), row.end());
+    }
+}
+
+/**
+ * @brief Swaps the elements of a square matrix across its horizontal axis of symmetry, in place.
+ * @pre The matrix must be square 
+ * 
+ * @param matrix A (non-const) reference to a square matrix (a 2D vector or an N x N array)
+ */
+template <typename Matrix>
+void Transform::flipAcrossHorizontalInPlace(Matrix& matrix) {
+    std::reverse(matrix.begin(), matrix.end());
+}
+
+namespace Transform {
+    namespace detail {
+        /**
+         * @brief Describes a symmetry as the flags of a View: whether (row, col) is read as (col, row), 
+         *      then whether the row and column read are mirrored
+         */
+        struct SymmetryFlags {
+            bool transpose;
+            bool mirror_rows;
+            bool mirror_cols;
+        };
+
+        constexpr SymmetryFlags flagsOf(const Symmetry& op) {
+            switch (op) {
+                case Symmetry::ROTATE_90:          return {true, true, false};
+                case Symmetry::ROTATE_180:         return {false, true, true};
+                case Symmetry::ROTATE_270:         return {true, false, true};
+                case Symmetry::FLIP_VERTICAL:      return {false, false, true};
+                case Symmetry::FLIP_HORIZONTAL:    return {false, true, false};
+                case Symmetry::FLIP_DIAGONAL:      return {true, false, false};
+                case Symmetry::FLIP_ANTI_DIAGONAL: return {true, true, true};
+                default:                           return {false, false, false};
+            }
+        }
+    }
+}
+
+/**
+ * @brief Finds which cell of a matrix ends up at (row, col) once the symmetry is applied
+ * 
+ * @param op A const reference to the Symmetry applied
+ * @param n A const reference to the number of rows & columns of the matrix
+ * @param row A const reference to the row of the transformed matrix
+ * @param col A const reference to the column of the transformed matrix
+ * @return The cell of the original matrix holding the value of the transformed cell (row, col)
+ */
+constexpr Transform::Cell Transform::sourceCell(const Symmetry& op, const int& n, const int& row, const int& col) {
+    detail::SymmetryFlags flags = detail::flagsOf(op);
+    int r = flags.transpose ? col : row;
+    int c = flags.transpose ? row : col;
+
+    return Cell{flags.mirror_rows ? n - 1 - r : r, flags.mirror_cols ? n - 1 - c : c};
+}
+
+namespace Transform {
+    namespace detail {
+        /**
+         * @brief Builds the table of compose(first, then) by matching where the composition sends a probe cell.
+         * On a 4x4 matrix, the cell (0, 1) is sent somewhere different by each of the 8 symmetries.
+         */
+        constexpr std::array<std::array<Symmetry, SYMMETRY_COUNT>, SYMMETRY_COUNT> compositionTable() {
+            std::array<std::array<Symmetry, SYMMETRY_COUNT>, SYMMETRY_COUNT> table{};
+            for (const Symmetry& first : ALL_SYMMETRIES) {
+                for (const Symmetry& then : ALL_SYMMETRIES) {
+                    Cell middle = sourceCell(then, 4, 0, 1);
+                    Cell source = sourceCell(first, 4, middle.row, middle.col);
+
+                    for (const Symmetry& op : ALL_SYMMETRIES) {
+                        if (sourceCell(op, 4, 0, 1) == source) { table[static_cast<int>(first)][static_cast<int>(then)] = op; }
+                    }
+                }
+            }
+
+            return table;
+        }
+
+        constexpr std::array<std::array<Symmetry, SYMMETRY_COUNT>, SYMMETRY_COUNT> COMPOSITION_TABLE = compositionTable();
+
+        constexpr std::array<Symmetry, SYMMETRY_COUNT> inverseTable() {
+            std::array<Symmetry, SYMMETRY_COUNT> table{};
+            for (const Symmetry& op : ALL_SYMMETRIES) {
+                for (const Symmetry& candidate : ALL_SYMMETRIES) {
+                    if (COMPOSITION_TABLE[static_cast<int>(op)][static_cast<int>(candidate)] == Symmetry::IDENTITY) { table[static_cast<int>(op)] = candidate; }
+                }
+            }
+
+            return table;
+        }
+
+        constexpr std::array<Symmetry, SYMMETRY_COUNT> INVERSE_TABLE = inverseTable();
+    }
+}
+
+/**
+ * @brief Composes two symmetries
+ * @return The single Symmetry equal to applying `first`, then `then`. Looked up in a table built at compile time.
+ */
+constexpr Transform::Symmetry Transform::compose(const Symmetry& first, const Symmetry& then) {
+    return detail::COMPOSITION_TABLE[static_cast<int>(first)][static_cast<int>(then)];
+}
+
+/**
+ * @brief Inverts a symmetry
+ * @return The Symmetry undoing `op`. Looked up in a table built at compile time.
+ */
+constexpr Transform::Symmetry Transform::inverse(const Symmetry& op) {
+    return detail::INVERSE_TABLE[static_cast<int>(op)];
+}
+
+/**
+ * @brief Constructs an untransformed view of a matrix
+ * @param matrix A const reference to a square matrix (a 2D vector or an N x N array)
+ */
+template <typename Matrix>
+Transform::View<Matrix>::View(const Matrix& matrix) : View(matrix, false, false, false) {}
+
+/**
+ * @brief Constructs a view reading cell (row, col) from the given cell of the matrix
+ * @param matrix A const reference to a square matrix (a 2D vector or an N x N array)
+ * @param transpose A const reference to a flag to read (col, row) instead of (row, col)
+ * @param mirrorRows A const reference to a flag to then mirror the row read
+ * @param mirrorCols A const reference to a flag to then mirror the column read
+ */
+template <typename Matrix>
+Transform::View<Matrix>::View(const Matrix& matrix, const bool& transpose, const bool& mirrorRows, const bool& mirrorCols)
+    : matrix_{&matrix}, transpose_{transpose}, mirror_rows_{mirrorRows}, mirror_cols_{mirrorCols} {}
+
+/**
+ * @brief Constructs a view of a matrix with a symmetry applied
+ * @param matrix A const reference to a square matrix (a 2D vector or an N x N array)
+ * @param op A const reference to the Symmetry applied by the view
+ */
+template <typename Matrix>
+Transform::View<Matrix>::View(const Matrix& matrix, const Symmetry& op)
+    : View(matrix, detail::flagsOf(op).transpose, detail::flagsOf(op).mirror_rows, detail::flagsOf(op).mirror_cols) {}
+
+/**
+ * @brief Gets the number of rows & columns of the view
+ */
+template <typename Matrix>
+int Transform::View<Matrix>::size() const {
+    return matrix_->size();
+}
+
+/**
+ * @brief Gets the cell (row, col) of the transformed matrix
+ * @return A const reference to the cell of the underlying matrix it comes from
+ */
+template <typename Matrix>
+const auto& Transform::View<Matrix>::operator()(const int& row, const int& col) const {
+    int n = size();
+    int r = transpose_ ? col : row;
+    int c = transpose_ ? row : col;
+
+    return (*matrix_)[mirror_rows_ ? n - 1 - r : r][mirror_cols_ ? n - 1 - c : c];
+}
+
+/**
+ * @brief Gets a view of this view rotated 90 degrees clockwise
+ */
+template <typename Matrix>
+Transform::View<Matrix> Transform::View<Matrix>::rotate() const {
+    // The rotated cell (i, j) is this view's cell (n - 1 - j, i)
+    return transpose_ ? View(*matrix_, false, mirror_rows_, !mirror_cols_) : View(*matrix_, true, !mirror_rows_, mirror_cols_);
+}
+
+/**
+ * @brief Gets a view of this view flipped across its vertical axis of symmetry
+ */
+template <typename Matrix>
+Transform::View<Matrix> Transform::View<Matrix>::flipAcrossVertical() const {
+    // The flipped cell (i, j) is this view's cell (i, n - 1 - j)
+    return transpose_ ? View(*matrix_, true, !mirror_rows_, mirror_cols_) : View(*matrix_, false, mirror_rows_, !mirror_cols_);
+}
+
+/**
+ * @brief Gets a view of this view flipped across its horizontal axis of symmetry
+ */
+template <typename Matrix>
+Transform::View<Matrix> Transform::View<Matrix>::flipAcrossHorizontal() const {
+    // The flipped cell (i, j) is this view's cell (n - 1 - i, j)
+    return transpose_ ? View(*matrix_, true, mirror_rows_, !mirror_cols_) : View(*matrix_, false, !mirror_rows_, mirror_cols_);
+}
+
+/**
+ * @brief Compares two views cell by cell, in row-major order
+ * @return A negative value if this view comes first, 0 if they are equal, a positive value otherwise
+ */
+template <typename Matrix>
+template <typename Other>
+int Transform::View<Matrix>::compare(const View<Other>& other) const {
+    if (size() != other.size()) { return size() < other.size() ? -1 : 1; }
+
+    int n = size();
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            if ((*this)(i, j) < other(i, j)) { return -1; }
+            if (other(i, j) < (*this)(i, j)) { return 1; }
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Copies the transformed cells into a new matrix
+ * @return A new 2D vector holding the transformed matrix
+ */
+template <typename Matrix>
+auto Transform::View<Matrix>::materialize() const {
+    typedef std::decay_t<decltype((*this)(0, 0))> T;
+
+    int n = size();
+    std::vector<std::vector<T>> result(n, std::vector<T>(n));
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            result[i][j] = (*this)(i, j);
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Determines whether two square matrices are rotations / flips of each other, without building any transformed copy
+ * 
+ * @param a A const reference to a square matrix
+ * @param b A const reference to a square matrix
+ * @return True if `a` is `b` after a rotation (0°, 90°, 180°, 270°), optionally followed by a flip. False otherwise.
+ */
+template <typename MatrixA, typename MatrixB>
+bool Transform::isTransformationOf(const MatrixA& a, const MatrixB& b) {
+    View<MatrixA> target(a);
+    View<MatrixB> transformed(b);
+
+    for (int i = 0; i < 4; i++) {
+        if (target.compare(transformed) == 0 || target.compare(transformed.flipAcrossVertical()) == 0) { return true; }
+        transformed = transformed.rotate();
+    }
+
+    return false;
+}
+
+/**
+ * @brief Applies a symmetry to a square matrix
+ * @pre The input 2D vector must be square
+ * 
+ * @param op A const reference to the Symmetry to apply
+ * @param matrix A const reference to a 2D vector of objects of type T
+ * @return A new 2D vector representing the transformed matrix
+ */
+template <typename T>
+std::vector<std::vector<T>> Transform::apply(const Symmetry& op, const std::vector<std::vector<T>>& matrix) {
+    return View<std::vector<std::vector<T>>>(matrix, op).materialize();
+}
+
+/**
+ * @brief Applies a symmetry to a fixed-size square matrix
+ * 
+ * @param op A const reference to the Symmetry to apply
+ * @param matrix A const reference to an N x N array of objects of type T
+ * @return A new array representing the transformed matrix
+ */
+template <typename T, size_t N>
+std::array<std::array<T, N>, N> Transform::apply(const Symmetry& op, const std::array<std::array<T, N>, N>& matrix) {
+    std::array<std::array<T, N>, N> result;
+
+    for (size_t i = 0; i < N; i++) {
+        for (size_t j = 0; j < N; j++) {
+            Cell source = sourceCell(op, N, i, j);
+            result[i][j] = matrix[source.row][source.col];
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Applies a symmetry to a queen placement, without building its board.
+ * @pre Every row holds exactly one queen (as in every n-queens solution)
+ * 
+ * @param op A const reference to the Symmetry to apply
+ * @param placement A const reference to a QueenPlacement
+ * @return The placement of the transformed board
+ */
+inline QueenPlacement Transform::apply(const Symmetry& op, const QueenPlacement& placement) {
+    int n = placement.size();
+    QueenPlacement result(n);
+
+    // The queen at (row, col) ends up on the cell whose source it is, which the inverse symmetry gives
+    Symmetry back = inverse(op);
+    for (int col = 0; col < n; col++) {
+        Cell target = sourceCell(back, n, placement[col], col);
+        result.setRow(target.col, target.row);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Applies a symmetry to a packed board
+ * 
+ * @param op A const reference to the Symmetry to apply
+ * @param board A const reference to a PackedBoard
+ * @return The transformed board
+ */
+inline Transform::PackedBoard Transform::apply(const Symmetry& op, const PackedBoard& board) {
+    switch (op) {
+        case Symmetry::ROTATE_90:          return rotate(board);
+        case Symmetry::ROTATE_180:         return flipAcrossHorizontal(flipAcrossVertical(board));
+        case Symmetry::ROTATE_270:         return flipAcrossHorizontal(flipAcrossDiagonal(board));
+        case Symmetry::FLIP_VERTICAL:      return flipAcrossVertical(board);
+        case Symmetry::FLIP_HORIZONTAL:    return flipAcrossHorizontal(board);
+        case Symmetry::FLIP_DIAGONAL:      return flipAcrossDiagonal(board);
+        case Symmetry::FLIP_ANTI_DIAGONAL: return flipAcrossAntiDiagonal(board);
+        default:                           return board;
+    }
+}
+
+/**
+ * @brief Computes the images of a square matrix under all 8 symmetries in a single pass over its cells
+ * 
+ * @param matrix A const reference to a square 2D vector of objects of type T
+ * @return An array holding the image of every Symmetry, indexed by its enumeration value
+ */
+template <typename T>
+std::array<std::vector<std::vector<T>>, Transform::SYMMETRY_COUNT> Transform::allImages(const std::vector<std::vector<T>>& matrix) {
+    int n = matrix.size();
+    std::array<std::vector<std::vector<T>>, SYMMETRY_COUNT> images;
+    for (auto& image : images) {
+        image.assign(n, std::vector<T>(n));
+    }
+
+    // Each cell (i, j) of every image comes from one of (i, j) or (j, i) with either coordinate mirrored
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            int mi = n - 1 - i;
+            int mj = n - 1 - j;
+            images[static_cast<int>(Symmetry::IDENTITY)][i][j] = matrix[i][j];
+            images[static_cast<int>(Symmetry::ROTATE_90)][i][j] = matrix[mj][i];
+            images[static_cast<int>(Symmetry::ROTATE_180)][i][j] = matrix[mi][mj];
+            images[static_cast<int>(Symmetry::ROTATE_270)][i][j] = matrix[j][mi];
+            images[static_cast<int>(Symmetry::FLIP_VERTICAL)][i][j] = matrix[i][mj];
+            images[static_cast<int>(Symmetry::FLIP_HORIZONTAL)][i][j] = matrix[mi][j];
+            images[static_cast<int>(Symmetry::FLIP_DIAGONAL)][i][j] = matrix[j][i];
+            images[static_cast<int>(Symmetry::FLIP_ANTI_DIAGONAL)][i][j] = matrix[mj][mi];
+        }
+    }
+
+    return images;
+}
+
+/**
+ * @brief Computes the images of a queen placement under all 8 symmetries in a single pass over its columns
+ * @pre Every row holds exactly one queen (as in every n-queens solution)
+ * 
+ * @param placement A const reference to a QueenPlacement
+ * @return An array holding the image of every Symmetry, indexed by its enumeration value
+ */
+inline std::array<QueenPlacement, Transform::SYMMETRY_COUNT> Transform::allImages(const QueenPlacement& placement) {
+    int n = placement.size();
+    std::array<QueenPlacement, SYMMETRY_COUNT> images;
+    images.fill(QueenPlacement(n));
+
+    // The queen at (r, c) lands on (r, c), (c, r), or either of those with a coordinate mirrored
+    for (int c = 0; c < n; c++) {
+        int r = placement[c];
+        int mr = n - 1 - r;
+        int mc = n - 1 - c;
+        images[static_cast<int>(Symmetry::IDENTITY)].setRow(c, r);
+        images[static_cast<int>(Symmetry::ROTATE_90)].setRow(mr, c);
+        images[static_cast<int>(Symmetry::ROTATE_180)].setRow(mc, mr);
+        images[static_cast<int>(Symmetry::ROTATE_270)].setRow(r, mc);
+        images[static_cast<int>(Symmetry::FLIP_VERTICAL)].setRow(mc, r);
+        images[static_cast<int>(Symmetry::FLIP_HORIZONTAL)].setRow(c, mr);
+        images[static_cast<int>(Symmetry::FLIP_DIAGONAL)].setRow(r, c);
+        images[static_cast<int>(Symmetry::FLIP_ANTI_DIAGONAL)].setRow(mr, mc);
+    }
+
+    return images;
+}
+
+/**
+ * @brief Computes the images of a packed board under all 8 symmetries, sharing the flips between them
+ * 
+ * @param board A const reference to a PackedBoard
+ * @return An array holding the image of every Symmetry, indexed by its enumeration value
+ */
+inline std::array<Transform::PackedBoard, Transform::SYMMETRY_COUNT> Transform::allImages(const PackedBoard& board) {
+    // Every image is a flip of either the board or its transpose
+    PackedBoard vertical = flipAcrossVertical(board);
+    PackedBoard transposed = flipAcrossDiagonal(board);
+    PackedBoard rotated = flipAcrossVertical(transposed);
+
+    std::array<PackedBoard, SYMMETRY_COUNT> images;
+    images[static_cast<int>(Symmetry::IDENTITY)] = board;
+    images[static_cast<int>(Symmetry::ROTATE_90)] = rotated;
+    images[static_cast<int>(Symmetry::ROTATE_180)] = flipAcrossHorizontal(vertical);
+    images[static_cast<int>(Symmetry::ROTATE_270)] = flipAcrossHorizontal(transposed);
+    images[static_cast<int>(Symmetry::FLIP_VERTICAL)] = vertical;
+    images[static_cast<int>(Symmetry::FLIP_HORIZONTAL)] = flipAcrossHorizontal(board);
+    images[static_cast<int>(Symmetry::FLIP_DIAGONAL)] = transposed;
+    images[static_cast<int>(Symmetry::FLIP_ANTI_DIAGONAL)] = flipAcrossHorizontal(rotated);
+
+    return images;
+}
+
+/**
+ * @brief Finds the symmetries that leave a board unchanged (its stabilizer)
+ * 
+ * @param board A const reference to a square matrix, QueenPlacement or PackedBoard
+ * @return A bitmask where bit i is set if the i-th Symmetry maps `board` onto itself (bit 0, the identity, is always set)
+ */
+template <typename Board>
+uint8_t Transform::stabilizer(const Board& board) {
+    auto images = allImages(board);
+
+    uint8_t fixed = 0;
+    for (int i = 0; i < SYMMETRY_COUNT; i++) {
+        if (images[i] == board) { fixed |= 1 << i; }
+    }
+
+    return fixed;
+}
+
+/**
+ * @brief Counts the distinct boards reachable from a board by its symmetries
+ * 
+ * @param board A const reference to a square matrix, QueenPlacement or PackedBoard
+ * @return The size of the board's orbit: 8 divided by the size of its stabilizer
+ */
+template <typename Board>
+int Transform::orbitSize(const Board& board) {
+    return SYMMETRY_COUNT / __builtin_popcount(stabilizer(board));
+}
+
+/**
+ * @brief Rotates a queen placement 90 degrees clockwise, without building its board.
+ * @pre Every row holds exactly one queen (as in every n-queens solution)
+ * 
+ * @param placement A const reference to a QueenPlacement
+ * @return The placement of the rotated board
+ */
+inline QueenPlacement Transform::rotate(const QueenPlacement& placement) {
+    int n = placement.size();
+    QueenPlacement result(n);
+
+    // The queen at (row, col) moves to (col, n - 1 - row)
+    for (int col = 0; col < n; col++) {
+        result.setRow(n - 1 - placement[col], col);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Flips a queen placement across its vertical axis of symmetry, without building its board.
+ * 
+ * @param placement A const reference to a QueenPlacement
+ * @return The placement of the flipped board
+ */
+inline QueenPlacement Transform::flipAcrossVertical(const QueenPlacement& placement) {
+    int n = placement.size();
+    QueenPlacement result(n);
+
+    for (int col = 0; col < n; col++) {
+        result.setRow(n - 1 - col, placement[col]);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Flips a queen placement across its horizontal axis of symmetry, without building its board.
+ * 
+ * @param placement A const reference to a QueenPlacement
+ * @return The placement of the flipped board
+ */
+inline QueenPlacement Transform::flipAcrossHorizontal(const QueenPlacement& placement) {
+    int n = placement.size();
+    QueenPlacement result(n);
+
+    for (int col = 0; col < n; col++) {
+        result.setRow(col, n - 1 - placement[col]);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Packs an 8x8 matrix into a PackedBoard
+ * @pre The input 2D vector must be 8x8
+ * 
+ * @param matrix A const reference to a 2D vector of chars
+ * @param empty A const reference to the char marking an empty cell. '*' by default.
+ * @return A PackedBoard with a bit set for every cell that is not `empty`
+ */
+inline Transform::PackedBoard Transform::pack(const std::vector<std::vector<char>>& matrix, const char& empty) {
+    uint64_t bits = 0;
+    for (int i = 0; i < 8; i++) {
+        for (int j = 0; j < 8; j++) {
+            if (matrix[i][j] != empty) { bits |= 1ull << (8 * i + j); }
+        }
+    }
+
+    return PackedBoard{bits};
+}
+
+/**
+ * @brief Unpacks a PackedBoard into an 8x8 matrix
+ * 
+ * @param board A const reference to a PackedBoard
+ * @param filled A const reference to the char written on occupied cells. 'Q' by default.
+ * @param empty A const reference to the char written on empty cells. '*' by default.
+ * @return A new 8x8 2D vector of chars
+ */
+inline std::vector<std::vector<char>> Transform::unpack(const PackedBoard& board, const char& filled, const char& empty) {
+    std::vector<std::vector<char>> matrix(8, std::vector<char>(8, empty));
+    for (int i = 0; i < 8; i++) {
+        for (int j = 0; j < 8; j++) {
+            if ((board.bits >> (8 * i + j)) & 1) { matrix[i][j] = filled; }
+        }
+    }
+
+    return matrix;
+}
+
+/**
+ * @brief Rotates a packed board 90 degrees clockwise (a transpose followed by a flip across the vertical axis)
+ * @param board A const reference to a PackedBoard
+ * @return The rotated board
+ */
+inline Transform::PackedBoard Transform::rotate(const PackedBoard& board) {
+    return flipAcrossVertical(flipAcrossDiagonal(board));
+}
+
+/**
+ * @brief Swaps the cells of a packed board across its vertical axis of symmetry, by reversing the bits of each byte
+ * @param board A const reference to a PackedBoard
+ * @return The transformed board
+ */
+inline Transform::PackedBoard Transform::flipAcrossVertical(const PackedBoard& board) {
+    const uint64_t k1 = 0x5555555555555555ull;
+    const uint64_t k2 = 0x3333333333333333ull;
+    const uint64_t k4 = 0x0f0f0f0f0f0f0f0full;
+
+    // Swap neighbouring bits, then pairs, then nibbles
+    uint64_t x = board.bits;
+    x = ((x >> 1) & k1) | ((x & k1) << 1);
+    x = ((x >> 2) & k2) | ((x & k2) << 2);
+    x = ((x >> 4) & k4) | ((x & k4) << 4);
+
+    return PackedBoard{x};
+}
+
+/**
+ * @brief Swaps the cells of a packed board across its horizontal axis of symmetry, by reversing its bytes
+ * @param board A const reference to a PackedBoard
+ * @return The transformed board
+ */
+inline Transform::PackedBoard Transform::flipAcrossHorizontal(const PackedBoard& board) {
+    return PackedBoard{__builtin_bswap64(board.bits)};
+}
+
+/**
+ * @brief Swaps the cells of a packed board across its main diagonal, (row, col) -> (col, row), with delta swaps
+ * @param board A const reference to a PackedBoard
+ * @return The transformed board
+ */
+inline Transform::PackedBoard Transform::flipAcrossDiagonal(const PackedBoard& board) {
+    const uint64_t k1 = 0x5500550055005500ull;
+    const uint64_t k2 = 0x3333000033330000ull;
+    const uint64_t k4 = 0x0f0f0f0f00000000ull;
+
+    // Swap 4x4 blocks, then 2x2 blocks, then single cells across the diagonal
+    uint64_t x = board.bits;
+    uint64_t t = k4 & (x ^ (x << 28));
+    x ^= t ^ (t >> 28);
+    t = k2 & (x ^ (x << 14));
+    x ^= t ^ (t >> 14);
+    t = k1 & (x ^ (x << 7));
+    x ^= t ^ (t >> 7);
+
+    return PackedBoard{x};
+}
+
+/**
+ * @brief Swaps the cells of a packed board across its anti-diagonal, (row, col) -> (7 - col, 7 - row), with delta swaps
+ * @param board A const reference to a PackedBoard
+ * @return The transformed board
+ */
+inline Transform::PackedBoard Transform::flipAcrossAntiDiagonal(const PackedBoard& board) {
+    const uint64_t k1 = 0xaa00aa00aa00aa00ull;
+    const uint64_t k2 = 0xcccc0000cccc0000ull;
+    const uint64_t k4 = 0xf0f0f0f00f0f0f0full;
+
+    uint64_t x = board.bits;
+    uint64_t t = x ^ (x << 36);
+    x ^= k4 & (t ^ (x >> 36));
+    t = k2 & (x ^ (x << 18));
+    x ^= t ^ (t >> 18);
+    t = k1 & (x ^ (x << 9));
+    x ^= t ^ (t >> 9);
+
+    return PackedBoard{x};
+}
@@ -9,8 +9,76 @@
 
  #pragma once 
  #include <vector>
+ #include <array>
  #include <algorithm>
+ #include <cstdint>
+ #include "QueenPlacement.hpp"
  namespace Transform {
+     /**
+      * @brief An 8x8 occupancy board packed into 64 bits.
+      * Bit (8 * row + col) is set when the cell (row, col) is occupied, so each byte holds one row.
+      */
+     struct PackedBoard {
+         uint64_t bits;
+
+         bool operator==(const PackedBoard& other) const { return bits == other.bits; }
+         bool operator!=(const PackedBoard& other) const { return bits != other.bits; }
+     };
+
+     /**
+      * @brief The 8 symmetries of a square (the dihedral group D4).
+      * Rotations are clockwise. Flips are across the named axis (the diagonal runs through (0, 0) and (n - 1, n - 1)).
+      */
+     enum class Symmetry : uint8_t {
+         IDENTITY,
+         ROTATE_90,
+         ROTATE_180,
+         ROTATE_270,
+         FLIP_VERTICAL,
+         FLIP_HORIZONTAL,
+         FLIP_DIAGONAL,
+         FLIP_ANTI_DIAGONAL
+     };
+
+     constexpr int SYMMETRY_COUNT = 8;
+
+     // Every symmetry, in enumeration order
+     constexpr std::array<Symmetry, SYMMETRY_COUNT> ALL_SYMMETRIES = {
+         Symmetry::IDENTITY, Symmetry::ROTATE_90, Symmetry::ROTATE_180, Symmetry::ROTATE_270,
+         Symmetry::FLIP_VERTICAL, Symmetry::FLIP_HORIZONTAL, Symmetry::FLIP_DIAGONAL, Symmetry::FLIP_ANTI_DIAGONAL
+     };
+
+     // A (row, col) position on a square matrix
+     struct Cell {
+         int row;
+         int col;
+
+         constexpr bool operator==(const Cell& other) const { return row == other.row && col == other.col; }
+     };
+
+     /**
+      * @brief Finds which cell of a matrix ends up at (row, col) once the symmetry is applied
+      * 
+      * @param op A const reference to the Symmetry applied
+      * @param n A const reference to the number of rows & columns of the matrix
+      * @param row A const reference to the row of the transformed matrix
+      * @param col A const reference to the column of the transformed matrix
+      * @return The cell of the original matrix holding the value of the transformed cell (row, col)
+      */
+     constexpr Cell sourceCell(const Symmetry& op, const int& n, const int& row, const int& col);
+
+     /**
+      * @brief Composes two symmetries
+      * @return The single Symmetry equal to applying `first`, then `then`. Looked up in a table built at compile time.
+      */
+     constexpr Symmetry compose(const Symmetry& first, const Symmetry& then);
+
+     /**
+      * @brief Inverts a symmetry
+      * @return The Symmetry undoing `op`. Looked up in a table built at compile time.
+      */
+     constexpr Symmetry inverse(const Symmetry& op);
+
      /**
       * @brief Rotates a square matrix 90 degrees clockwise.
       * @pre The input 2D vector must be square 
@@ -43,6 +111,316 @@
       */
      template <typename T>
      std::vector<std::vector<T>> flipAcrossHorizontal(const std::vector<std::vector<T>>& matrix);
+
+     /**
+      * @brief Rotates a fixed-size square matrix 90 degrees clockwise.
+      * @note The size is known at compile time, so the loops can be fully unrolled and nothing is heap-allocated.
+      * 
+      * @param matrix A const reference to an N x N array of objects of type T
+      * @return A new array representing the rotated matrix
+      */
+     template <typename T, size_t N>
+     std::array<std::array<T, N>, N> rotate(const std::array<std::array<T, N>, N>& matrix);
+
+     /**
+      * @brief Swaps the elements of a fixed-size square matrix across its vertical axis of symmetry
+      * 
+      * @param matrix A const reference to an N x N array of objects of type T
+      * @return A new array representing the transformed matrix
+      */
+     template <typename T, size_t N>
+     std::array<std::array<T, N>, N> flipAcrossVertical(const std::array<std::array<T, N>, N>& matrix);
+
+     /**
+      * @brief Swaps the elements of a fixed-size square matrix across its horizontal axis of symmetry
+      * 
+      * @param matrix A const reference to an N x N array of objects of type T
+      * @return A new array representing the transformed matrix
+      */
+     template <typename T, size_t N>
+     std::array<std::array<T, N>, N> flipAcrossHorizontal(const std::array<std::array<T, N>, N>& matrix);
+
+     /**
+      * @brief Rotates a square matrix 90 degrees clockwise, in place.
+      * @pre The matrix must be square 
+      * 
+      * @param matrix A (non-const) reference to a square matrix (a 2D vector or an N x N array)
+      */
+     template <typename Matrix>
+     void rotateInPlace(Matrix& matrix);
+
+     /**
+      * @brief Swaps the elements of a square matrix across its vertical axis of symmetry, in place.
+      * @pre The matrix must be square 
+      * 
+      * @param matrix A (non-const) reference to a square matrix (a 2D vector or an N x N array)
+      */
+     template <typename Matrix>
+     void flipAcrossVerticalInPlace(Matrix& matrix);
+
+     /**
+      * @brief Swaps the elements of a square matrix across its horizontal axis of symmetry, in place.
+      * @pre The matrix must be square 
+      * 
+      * @param matrix A (non-const) reference to a square matrix (a 2D vector or an N x N array)
+      */
+     template <typename Matrix>
+     void flipAcrossHorizontalInPlace(Matrix& matrix);
+
+     /**
+      * @class View
+      * @brief A lazily transformed, read-only view of a square matrix.
+      * 
+      * A view never copies the matrix: it remaps each (row, col) it is asked for to the cell 
+      * of the underlying matrix it comes from. Every rotation / flip of a square matrix reads 
+      * cell (row, col) or (col, row), with either coordinate optionally mirrored, so a view is 
+      * three flags and transforming a view only updates them.
+      * @note The view holds a pointer to the matrix, which must outlive it.
+      */
+     template <typename Matrix>
+     class View {
+         private:
+             const Matrix* matrix_;
+             bool transpose_;    // Read (col, row) instead of (row, col)
+             bool mirror_rows_;  // Then read row (n - 1 - row)
+             bool mirror_cols_;  // Then read col (n - 1 - col)
+
+         public:
+             /**
+              * @brief Constructs an untransformed view of a matrix
+              * @param matrix A const reference to a square matrix (a 2D vector or an N x N array)
+              */
+             View(const Matrix& matrix);
+
+             /**
+              * @brief Constructs a view reading cell (row, col) from the given cell of the matrix
+              * @param matrix A const reference to a square matrix (a 2D vector or an N x N array)
+              * @param transpose A const reference to a flag to read (col, row) instead of (row, col)
+              * @param mirrorRows A const reference to a flag to then mirror the row read
+              * @param mirrorCols A const reference to a flag to then mirror the column read
+              */
+             View(const Matrix& matrix, const bool& transpose, const bool& mirrorRows, const bool& mirrorCols);
+
+             /**
+              * @brief Constructs a view of a matrix with a symmetry applied
+              * @param matrix A const reference to a square matrix (a 2D vector or an N x N array)
+              * @param op A const reference to the Symmetry applied by the view
+              */
+             View(const Matrix& matrix, const Symmetry& op);
+
+             /**
+              * @brief Gets the number of rows & columns of the view
+              */
+             int size() const;
+
+             /**
+              * @brief Gets the cell (row, col) of the transformed matrix
+              * @return A const reference to the cell of the underlying matrix it comes from
+              */
+             const auto& operator()(const int& row, const int& col) const;
+
+             /**
+              * @brief Gets a view of this view rotated 90 degrees clockwise
+              */
+             View rotate() const;
+
+             /**
+              * @brief Gets a view of this view flipped across its vertical axis of symmetry
+              */
+             View flipAcrossVertical() const;
+
+             /**
+              * @brief Gets a view of this view flipped across its horizontal axis of symmetry
+              */
+             View flipAcrossHorizontal() const;
+
+             /**
+              * @brief Compares two views cell by cell, in row-major order
+              * @return A negative value if this view comes first, 0 if they are equal, a positive value otherwise
+              */
+             template <typename Other>
+             int compare(const View<Other>& other) const;
+
+             /**
+              * @brief Copies the transformed cells into a new matrix
+              * @return A new 2D vector holding the transformed matrix
+              */
+             auto materialize() const;
+     };
+
+     /**
+      * @brief Determines whether two square matrices are rotations / flips of each other, without building any transformed copy
+      * 
+      * @param a A const reference to a square matrix
+      * @param b A const reference to a square matrix
+      * @return True if `a` is `b` after a rotation (0°, 90°, 180°, 270°), optionally followed by a flip. False otherwise.
+      */
+     template <typename MatrixA, typename MatrixB>
+     bool isTransformationOf(const MatrixA& a, const MatrixB& b);
+
+     /**
+      * @brief Applies a symmetry to a square matrix
+      * @pre The input 2D vector must be square
+      * 
+      * @param op A const reference to the Symmetry to apply
+      * @param matrix A const reference to a 2D vector of objects of type T
+      * @return A new 2D vector representing the transformed matrix
+      */
+     template <typename T>
+     std::vector<std::vector<T>> apply(const Symmetry& op, const std::vector<std::vector<T>>& matrix);
+
+     /**
+      * @brief Applies a symmetry to a fixed-size square matrix
+      * 
+      * @param op A const reference to the Symmetry to apply
+      * @param matrix A const reference to an N x N array of objects of type T
+      * @return A new array representing the transformed matrix
+      */
+     template <typename T, size_t N>
+     std::array<std::array<T, N>, N> apply(const Symmetry& op, const std::array<std::array<T, N>, N>& matrix);
+
+     /**
+      * @brief Applies a symmetry to a queen placement, without building its board.
+      * @pre Every row holds exactly one queen (as in every n-queens solution)
+      * 
+      * @param op A const reference to the Symmetry to apply
+      * @param placement A const reference to a QueenPlacement
+      * @return The placement of the transformed board
+      */
+     inline QueenPlacement apply(const Symmetry& op, const QueenPlacement& placement);
+
+     /**
+      * @brief Applies a symmetry to a packed board
+      * 
+      * @param op A const reference to the Symmetry to apply
+      * @param board A const reference to a PackedBoard
+      * @return The transformed board
+      */
+     inline PackedBoard apply(const Symmetry& op, const PackedBoard& board);
+
+     /**
+      * @brief Computes the images of a square matrix under all 8 symmetries in a single pass over its cells
+      * 
+      * @param matrix A const reference to a square 2D vector of objects of type T
+      * @return An array holding the image of every Symmetry, indexed by its enumeration value
+      */
+     template <typename T>
+     std::array<std::vector<std::vector<T>>, SYMMETRY_COUNT> allImages(const std::vector<std::vector<T>>& matrix);
+
+     /**
+      * @brief Computes the images of a queen placement under all 8 symmetries in a single pass over its columns
+      * @pre Every row holds exactly one queen (as in every n-queens solution)
+      * 
+      * @param placement A const reference to a QueenPlacement
+      * @return An array holding the image of every Symmetry, indexed by its enumeration value
+      */
+     inline std::array<QueenPlacement, SYMMETRY_COUNT> allImages(const QueenPlacement& placement);
+
+     /**
+      * @brief Computes the images of a packed board under all 8 symmetries, sharing the flips between them
+      * 
+      * @param board A const reference to a PackedBoard
+      * @return An array holding the image of every Symmetry, indexed by its enumeration value
+      */
+     inline std::array<PackedBoard, SYMMETRY_COUNT> allImages(const PackedBoard& board);
+
+     /**
+      * @brief Finds the symmetries that leave a board unchanged (its stabilizer)
+      * 
+      * @param board A const reference to a square matrix, QueenPlacement or PackedBoard
+      * @return A bitmask where bit i is set if the i-th Symmetry maps `board` onto itself (bit 0, the identity, is always set)
+      */
+     template <typename Board>
+     uint8_t stabilizer(const Board& board);
+
+     /**
+      * @brief Counts the distinct boards reachable from a board by its symmetries
+      * 
+      * @param board A const reference to a square matrix, QueenPlacement or PackedBoard
+      * @return The size of the board's orbit: 8 divided by the size of its stabilizer
+      */
+     template <typename Board>
+     int orbitSize(const Board& board);
+
+     /**
+      * @brief Rotates a queen placement 90 degrees clockwise, without building its board.
+      * @pre Every row holds exactly one queen (as in every n-queens solution)
+      * 
+      * @param placement A const reference to a QueenPlacement
+      * @return The placement of the rotated board
+      */
+     inline QueenPlacement rotate(const QueenPlacement& placement);
+
+     /**
+      * @brief Flips a queen placement across its vertical axis of symmetry, without building its board.
+      * 
+      * @param placement A const reference to a QueenPlacement
+      * @return The placement of the flipped board
+      */
+     inline QueenPlacement flipAcrossVertical(const QueenPlacement& placement);
+
+     /**
+      * @brief Flips a queen placement across its horizontal axis of symmetry, without building its board.
+      * 
+      * @param placement A const reference to a QueenPlacement
+      * @return The placement of the flipped board
+      */
+     inline QueenPlacement flipAcrossHorizontal(const QueenPlacement& placement);
+
+     /**
+      * @brief Packs an 8x8 matrix into a PackedBoard
+      * @pre The input 2D vector must be 8x8
+      * 
+      * @param matrix A const reference to a 2D vector of chars
+      * @param empty A const reference to the char marking an empty cell. '*' by default.
+      * @return A PackedBoard with a bit set for every cell that is not `empty`
+      */
+     inline PackedBoard pack(const std::vector<std::vector<char>>& matrix, const char& empty = '*');
+
+     /**
+      * @brief Unpacks a PackedBoard into an 8x8 matrix
+      * 
+      * @param board A const reference to a PackedBoard
+      * @param filled A const reference to the char written on occupied cells. 'Q' by default.
+      * @param empty A const reference to the char written on empty cells. '*' by default.
+      * @return A new 8x8 2D vector of chars
+      */
+     inline std::vector<std::vector<char>> unpack(const PackedBoard& board, const char& filled = 'Q', const char& empty = '*');
+
+     /**
+      * @brief Rotates a packed board 90 degrees clockwise (a transpose followed by a flip across the vertical axis)
+      * @param board A const reference to a PackedBoard
+      * @return The rotated board
+      */
+     inline PackedBoard rotate(const PackedBoard& board);
+
+     /**
+      * @brief Swaps the cells of a packed board across its vertical axis of symmetry, by reversing the bits of each byte
+      * @param board A const reference to a PackedBoard
+      * @return The transformed board
+      */
+     inline PackedBoard flipAcrossVertical(const PackedBoard& board);
+
+     /**
+      * @brief Swaps the cells of a packed board across its horizontal axis of symmetry, by reversing its bytes
+      * @param board A const reference to a PackedBoard
+      * @return The transformed board
+      */
+     inline PackedBoard flipAcrossHorizontal(const PackedBoard& board);
+
+     /**
+      * @brief Swaps the cells of a packed board across its main diagonal, (row, col) -> (col, row), with delta swaps
+      * @param board A const reference to a PackedBoard
+      * @return The transformed board
+      */
+     inline PackedBoard flipAcrossDiagonal(const PackedBoard& board);
+
+     /**
+      * @brief Swaps the cells of a packed board across its anti-diagonal, (row, col) -> (7 - col, 7 - row), with delta swaps
+      * @param board A const reference to a PackedBoard
+      * @return The transformed board
+      */
+     inline PackedBoard flipAcrossAntiDiagonal(const PackedBoard& board);
  };
  
  #include "Transform.cpp"
\ No newline at end of file
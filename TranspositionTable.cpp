@@ -0,0 +1,220 @@
+#include "TranspositionTable.hpp"
+#include <algorithm>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace {
+    // The field layout of an entry's data word
+    constexpr int SCORE_SHIFT = 16;
+    constexpr int EVAL_SHIFT = 32;
+    constexpr int DEPTH_SHIFT = 48;
+    constexpr int BOUND_SHIFT = 56;
+    constexpr int GENERATION_SHIFT = 58;
+    constexpr int GENERATIONS = 64;
+};
+
+/**
+ * @brief Allocates the table.
+ * @note On Linux the memory is mapped directly & advised to use huge pages (transparent huge pages),
+ *      which cuts the TLB misses of random probes. Elsewhere it is allocated with aligned new.
+ *
+ * @param megabytes A const reference to the size of the table in MB. The largest power of 2 of buckets
+ *      that fits is used (at least 1 bucket).
+ * @post Every entry is empty
+ */
+TranspositionTable::TranspositionTable(const size_t& megabytes) : buckets_{nullptr}, bucketCount_{1}, mapped_{false}, generation_{0} {
+    while ((bucketCount_ * 2) * sizeof(Bucket) <= (megabytes << 20)) { bucketCount_ *= 2; }
+
+#ifdef __linux__
+    // Fresh anonymous pages are zero, which is an empty entry
+    void* memory = mmap(nullptr, sizeInBytes(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory != MAP_FAILED) {
+#ifdef MADV_HUGEPAGE
+        madvise(memory, sizeInBytes(), MADV_HUGEPAGE);
+#endif
+        buckets_ = static_cast<Bucket*>(memory);
+        mapped_ = true;
+        return;
+    }
+#endif
+
+    buckets_ = new Bucket[bucketCount_];
+    clear();
+}
+
+/**
+ * @brief Destructor. Frees the table.
+ */
+TranspositionTable::~TranspositionTable() {
+#ifdef __linux__
+    if (mapped_) {
+        munmap(buckets_, sizeInBytes());
+        return;
+    }
+#endif
+
+    delete[] buckets_;
+}
+
+/**
+ * @brief Packs a result into the data word of an entry
+ */
+uint64_t TranspositionTable::pack(const Move& move, const int& score, const int& eval, const int& depth, const Bound& bound) const {
+    return static_cast<uint64_t>(move.raw()) |
+        (static_cast<uint64_t>(static_cast<uint16_t>(score)) << SCORE_SHIFT) |
+        (static_cast<uint64_t>(static_cast<uint16_t>(eval)) << EVAL_SHIFT) |
+        (static_cast<uint64_t>(static_cast<uint8_t>(depth)) << DEPTH_SHIFT) |
+        (static_cast<uint64_t>(bound) << BOUND_SHIFT) |
+        (static_cast<uint64_t>(generation_) << GENERATION_SHIFT);
+}
+
+/**
+ * @brief Unpacks the data word of an entry
+ */
+TranspositionTable::Data TranspositionTable::unpack(const uint64_t& data) {
+    Data unpacked;
+    unpacked.move = Move(data & 0x3F, (data >> 6) & 0x3F, (data >> 12) & 0xF);
+    unpacked.score = static_cast<int16_t>(data >> SCORE_SHIFT);
+    unpacked.eval = static_cast<int16_t>(data >> EVAL_SHIFT);
+    unpacked.depth = static_cast<int8_t>(data >> DEPTH_SHIFT);
+    unpacked.bound = static_cast<Bound>((data >> BOUND_SHIFT) & 0x3);
+
+    return unpacked;
+}
+
+/**
+ * @brief Gets the bucket a key lives in
+ */
+TranspositionTable::Bucket& TranspositionTable::bucketOf(const Zobrist::Key& key) const {
+    return buckets_[key & (bucketCount_ - 1)];
+}
+
+/**
+ * @brief Looks up the result stored for a position
+ *
+ * @param key A const reference to the Zobrist hash of the position
+ * @param data A (non-const) reference set to the stored result, if one is found
+ * @return True if a result was found for `key`. False otherwise (`data` is left unchanged).
+ */
+bool TranspositionTable::probe(const Zobrist::Key& key, Data& data) const {
+    Bucket& bucket = bucketOf(key);
+
+    for (Entry& entry : bucket.entries) {
+        uint64_t word = entry.data.load(std::memory_order_relaxed);
+        if ((entry.check.load(std::memory_order_relaxed) ^ word) != key || ((word >> BOUND_SHIFT) & 0x3) == NONE) { continue; }
+
+        data = unpack(word);
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Stores the result of a search.
+ *
+ * The entry of the same position is overwritten unless it holds a deeper result from the current search
+ * (an EXACT bound always overwrites). A store without a move keeps the move already stored for the position.
+ * Otherwise the emptiest, shallowest or oldest entry of the bucket is replaced.
+ *
+ * @param key A const reference to the Zobrist hash of the position
+ * @param move A const reference to the best move found, Move::none() if there is none
+ * @param score A const reference to the score, in [-32768, 32767]
+ * @param eval A const reference to the static evaluation, in [-32767, 32767], or NO_EVAL
+ * @param depth A const reference to the depth searched, in [-128, 127]
+ * @param bound A const reference to the Bound of the score
+ */
+void TranspositionTable::store(const Zobrist::Key& key, const Move& move, const int& score, const int& eval, const int& depth, const Bound& bound) {
+    Bucket& bucket = bucketOf(key);
+
+    Entry* victim = nullptr;
+    int victimWorth = 0;
+
+    for (Entry& entry : bucket.entries) {
+        uint64_t word = entry.data.load(std::memory_order_relaxed);
+
+        if ((entry.check.load(std::memory_order_relaxed) ^ word) == key) {
+            Data old = unpack(word);
+            int oldGeneration = static_cast<int>(word >> GENERATION_SHIFT);
+
+            // Keep a deeper result of this search, unless the new one is exact
+            if (bound != EXACT && oldGeneration == generation_ && old.depth > depth && old.bound != NONE) { return; }
+
+            uint64_t data = pack(move == Move::none() ? old.move : move, score, eval, depth, bound);
+            entry.data.store(data, std::memory_order_relaxed);
+            entry.check.store(key ^ data, std::memory_order_relaxed);
+            return;
+        }
+
+        // An entry is worth its depth, less 8 plies per search it has aged. Empty entries are worth nothing.
+        int age = (GENERATIONS + generation_ - static_cast<int>(word >> GENERATION_SHIFT)) % GENERATIONS;
+        int worth = ((word >> BOUND_SHIFT) & 0x3) == NONE ? -1000 : static_cast<int8_t>(word >> DEPTH_SHIFT) - 8 * age;
+        if (!victim || worth < victimWorth) {
+            victim = &entry;
+            victimWorth = worth;
+        }
+    }
+
+    uint64_t data = pack(move, score, eval, depth, bound);
+    victim->data.store(data, std::memory_order_relaxed);
+    victim->check.store(key ^ data, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Asks the CPU to start loading the bucket of a key, ahead of a probe or store
+ * @param key A const reference to the Zobrist hash of the position
+ */
+void TranspositionTable::prefetch(const Zobrist::Key& key) const {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(&bucketOf(key));
+#endif
+}
+
+/**
+ * @brief Starts a new search: the entries already stored age by one, so they are replaced first
+ * @pre No thread is probing or storing
+ */
+void TranspositionTable::newSearch() {
+    generation_ = (generation_ + 1) % GENERATIONS;
+}
+
+/**
+ * @brief Empties every entry
+ * @pre No thread is probing or storing
+ */
+void TranspositionTable::clear() {
+    for (size_t i = 0; i < bucketCount_; i++) {
+        for (Entry& entry : buckets_[i].entries) {
+            entry.check.store(0, std::memory_order_relaxed);
+            entry.data.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * @brief Estimates how full the table is, from a sample of its first buckets
+ * @return The permille of sampled entries written during the current search, in [0, 1000]
+ */
+int TranspositionTable::hashfull() const {
+    size_t sampled = std::min<size_t>(bucketCount_, 1000 / BUCKET_SIZE);
+    int used = 0;
+
+    for (size_t i = 0; i < sampled; i++) {
+        for (const Entry& entry : buckets_[i].entries) {
+            uint64_t word = entry.data.load(std::memory_order_relaxed);
+            if (((word >> BOUND_SHIFT) & 0x3) != NONE && static_cast<int>(word >> GENERATION_SHIFT) == generation_) { used++; }
+        }
+    }
+
+    return static_cast<int>(used * 1000 / (sampled * BUCKET_SIZE));
+}
+
+/**
+ * @brief Gets the size of the table
+ * @return The number of bytes allocated for its buckets
+ */
+size_t TranspositionTable::sizeInBytes() const {
+    return bucketCount_ * sizeof(Bucket);
+}
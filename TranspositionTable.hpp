@@ -0,0 +1,150 @@
+/**
+ * @class TranspositionTable
+ * @brief A fixed-size cache of search results keyed by the Zobrist hash of a position (see ChessBoard::getHash),
+ *      shared by any number of threads without locks.
+ *
+ * The table is allocated once, when it is constructed, as an array of 64-byte buckets (one cache line each)
+ * holding 4 entries. An entry packs its result into one 64-bit word and stores it next to key ^ data, in two
+ * relaxed atomics. A reader accepts an entry only if the two words XOR back to its key, so an entry torn by
+ * a concurrent store reads as a miss instead of as the result of another position.
+ *
+ * When a bucket is full, a store replaces the entry worth the least: the shallowest search, aged by how
+ * many searches ago it was written (see newSearch).
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "Move.hpp"
+#include "Zobrist.hpp"
+
+class TranspositionTable {
+    public:
+        // How the stored score bounds the true score of the position
+        enum Bound : uint8_t { NONE, UPPER, LOWER, EXACT };
+
+        /**
+         * @brief A search result, as stored in & read from the table
+         */
+        struct Data {
+            Move move;          // The best move found, Move::none() if there is none
+            int16_t score;      // The score of the search
+            int16_t eval;       // The static evaluation of the position, NO_EVAL if the search did not compute it
+            int8_t depth;       // The depth searched
+            Bound bound;
+        };
+
+        // The number of entries sharing a bucket (and a cache line)
+        static constexpr int BUCKET_SIZE = 4;
+
+        // The eval stored for a position the search did not evaluate statically
+        static constexpr int NO_EVAL = INT16_MIN;
+
+    private:
+        struct Entry {
+            std::atomic<uint64_t> check;    // key ^ data
+            std::atomic<uint64_t> data;     // move (16 bits) | score (16) | eval (16) | depth (8) | bound (2) | generation (6)
+        };
+
+        struct alignas(64) Bucket {
+            Entry entries[BUCKET_SIZE];
+        };
+
+        Bucket* buckets_;
+        size_t bucketCount_;            // A power of 2
+        bool mapped_;                   // True if buckets_ was mapped from the OS (and must be unmapped)
+        uint8_t generation_;            // The age of the current search, in [0, 64)
+
+        /**
+         * @brief Packs a result into the data word of an entry
+         */
+        uint64_t pack(const Move& move, const int& score, const int& eval, const int& depth, const Bound& bound) const;
+
+        /**
+         * @brief Unpacks the data word of an entry
+         */
+        static Data unpack(const uint64_t& data);
+
+        /**
+         * @brief Gets the bucket a key lives in
+         */
+        Bucket& bucketOf(const Zobrist::Key& key) const;
+
+    public:
+        /**
+         * @brief Allocates the table.
+         * @note On Linux the memory is mapped directly & advised to use huge pages (transparent huge pages),
+         *      which cuts the TLB misses of random probes. Elsewhere it is allocated with aligned new.
+         *
+         * @param megabytes A const reference to the size of the table in MB. The largest power of 2 of buckets
+         *      that fits is used (at least 1 bucket).
+         * @post Every entry is empty
+         */
+        explicit TranspositionTable(const size_t& megabytes);
+
+        // The table owns a large block of memory, so it is never copied
+        TranspositionTable(const TranspositionTable&) = delete;
+        TranspositionTable& operator=(const TranspositionTable&) = delete;
+
+        /**
+         * @brief Destructor. Frees the table.
+         */
+        ~TranspositionTable();
+
+        /**
+         * @brief Looks up the result stored for a position
+         *
+         * @param key A const reference to the Zobrist hash of the position
+         * @param data A (non-const) reference set to the stored result, if one is found
+         * @return True if a result was found for `key`. False otherwise (`data` is left unchanged).
+         */
+        bool probe(const Zobrist::Key& key, Data& data) const;
+
+        /**
+         * @brief Stores the result of a search.
+         *
+         * The entry of the same position is overwritten unless it holds a deeper result from the current search
+         * (an EXACT bound always overwrites). A store without a move keeps the move already stored for the position.
+         * Otherwise the emptiest, shallowest or oldest entry of the bucket is replaced.
+         *
+         * @param key A const reference to the Zobrist hash of the position
+         * @param move A const reference to the best move found, Move::none() if there is none
+         * @param score A const reference to the score, in [-32768, 32767]
+         * @param eval A const reference to the static evaluation, in [-32767, 32767], or NO_EVAL
+         * @param depth A const reference to the depth searched, in [-128, 127]
+         * @param bound A const reference to the Bound of the score
+         */
+        void store(const Zobrist::Key& key, const Move& move, const int& score, const int& eval, const int& depth, const Bound& bound);
+
+        /**
+         * @brief Asks the CPU to start loading the bucket of a key, ahead of a probe or store
+         * @param key A const reference to the Zobrist hash of the position
+         */
+        void prefetch(const Zobrist::Key& key) const;
+
+        /**
+         * @brief Starts a new search: the entries already stored age by one, so they are replaced first
+         * @pre No thread is probing or storing
+         */
+        void newSearch();
+
+        /**
+         * @brief Empties every entry
+         * @pre No thread is probing or storing
+         */
+        void clear();
+
+        /**
+         * @brief Estimates how full the table is, from a sample of its first buckets
+         * @return The permille of sampled entries written during the current search, in [0, 1000]
+         */
+        int hashfull() const;
+
+        /**
+         * @brief Gets the size of the table
+         * @return The number of bytes allocated for its buckets
+         */
+        size_t sizeInBytes() const;
+};
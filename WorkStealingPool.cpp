@@ -0,0 +1,89 @@
+#include "WorkStealingPool.hpp"
+#include <thread>
+#include <algorithm>
+
+/**
+ * @brief Constructs a pool of workers
+ * @param threads A const reference to the number of worker threads. If not positive, the hardware concurrency is used instead.
+ */
+WorkStealingPool::WorkStealingPool(const int& threads) : thread_count_{threads} {
+    if (thread_count_ < 1) {
+        thread_count_ = std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+
+/**
+ * @brief Gets the number of worker threads
+ * @return The value stored in thread_count_
+ */
+int WorkStealingPool::size() const {
+    return thread_count_;
+}
+
+/**
+ * @brief Takes the next task for a worker: first from the back of its own queue, then from the front of any other queue
+ * 
+ * @param worker A const reference to the index of the worker looking for a task
+ * @param queues A (non-const) reference to the queues of all workers
+ * @param task A (non-const) reference that is set to the index of the task taken
+ * @return True if a task was taken. False if every queue is empty.
+ */
+bool WorkStealingPool::takeTask(const int& worker, std::vector<WorkQueue>& queues, size_t& task) {
+    {
+        std::lock_guard<std::mutex> guard(queues[worker].lock);
+        if (!queues[worker].tasks.empty()) {
+            task = queues[worker].tasks.back();
+            queues[worker].tasks.pop_back();
+            return true;
+        }
+    }
+
+    // Steal the oldest task of the next non-empty queue
+    int n = queues.size();
+    for (int i = 1; i < n; i++) {
+        WorkQueue& victim = queues[(worker + i) % n];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if (!victim.tasks.empty()) {
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Runs every task in the batch and blocks until all of them have finished.
+ * @note Tasks are dealt to the workers round-robin, so with a single worker they run in order on the calling thread.
+ * 
+ * @param tasks A const reference to the tasks to run
+ */
+void WorkStealingPool::run(const std::vector<Task>& tasks) const {
+    if (thread_count_ == 1) {
+        for (const Task& task : tasks) { task(0); }
+        return;
+    }
+
+    std::vector<WorkQueue> queues(thread_count_);
+    // Push in reverse so that each worker pops its tasks in increasing order
+    for (size_t i = tasks.size(); i-- > 0; ) {
+        queues[i % thread_count_].tasks.push_back(i);
+    }
+
+    auto work = [&tasks, &queues] (const int& worker) {
+        size_t task;
+        while (takeTask(worker, queues, task)) {
+            tasks[task](worker);
+        }
+    };
+
+    // The calling thread acts as worker 0
+    std::vector<std::thread> threads;
+    for (int i = 1; i < thread_count_; i++) {
+        threads.emplace_back(work, i);
+    }
+    work(0);
+
+    for (std::thread& t : threads) { t.join(); }
+}
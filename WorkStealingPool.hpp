@@ -0,0 +1,60 @@
+/**
+ * @class WorkStealingPool
+ * @brief Runs a batch of independent tasks over a fixed number of worker threads.
+ * 
+ * Each worker owns a deque of tasks. A worker takes tasks from the back of its own deque,
+ * and once it runs dry it steals from the front of the other workers' deques, so uneven 
+ * tasks still keep every thread busy until the whole batch is done.
+ */
+
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <functional>
+
+class WorkStealingPool {
+    public:
+        // A task receives the index of the worker running it, in [0, size()), so callers can keep per-worker buffers
+        typedef std::function<void(const int& worker)> Task;
+
+    private:
+        struct WorkQueue {
+            std::mutex lock;
+            std::deque<size_t> tasks;    // Indices into the batch being run
+        };
+
+        int thread_count_;
+
+        /**
+         * @brief Takes the next task for a worker: first from the back of its own queue, then from the front of any other queue
+         * 
+         * @param worker A const reference to the index of the worker looking for a task
+         * @param queues A (non-const) reference to the queues of all workers
+         * @param task A (non-const) reference that is set to the index of the task taken
+         * @return True if a task was taken. False if every queue is empty.
+         */
+        static bool takeTask(const int& worker, std::vector<WorkQueue>& queues, size_t& task);
+
+    public:
+        /**
+         * @brief Constructs a pool of workers
+         * @param threads A const reference to the number of worker threads. If not positive, the hardware concurrency is used instead.
+         */
+        WorkStealingPool(const int& threads = 0);
+
+        /**
+         * @brief Gets the number of worker threads
+         * @return The value stored in thread_count_
+         */
+        int size() const;
+
+        /**
+         * @brief Runs every task in the batch and blocks until all of them have finished.
+         * @note Tasks are dealt to the workers round-robin, so with a single worker they run in order on the calling thread.
+         * 
+         * @param tasks A const reference to the tasks to run
+         */
+        void run(const std::vector<Task>& tasks) const;
+};
@@ -0,0 +1,84 @@
+#include "Zobrist.hpp"
+
+namespace Zobrist {
+    namespace detail {
+        /**
+         * @brief Advances a splitmix64 generator
+         * @param state A (non-const) reference to the state of the generator
+         * @return The next 64-bit number of the sequence
+         */
+        constexpr Key splitmix(Key& state) {
+            Key value = (state += 0x9E3779B97F4A7C15ull);
+            value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+            value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+            return value ^ (value >> 31);
+        }
+
+        /**
+         * @brief Every key of the hash, drawn from one seeded sequence
+         */
+        struct Keys {
+            std::array<std::array<std::array<Key, SQUARES>, TYPES>, COLORS> pieces;
+            std::array<Key, 16> castling;
+            std::array<Key, 8> enPassant;
+            Key side;
+        };
+
+        constexpr Keys makeKeys() {
+            Keys keys{};
+            Key state = 0x5A17C0FFEEull;
+
+            for (int color = 0; color < COLORS; color++) {
+                // Type 0 is an empty square, which leaves the hash unchanged
+                for (int type = 1; type < TYPES; type++) {
+                    for (int square = 0; square < SQUARES; square++) { keys.pieces[color][type][square] = splitmix(state); }
+                }
+            }
+
+            // No rights keep a key of 0, so a position without castling hashes its pieces & side only
+            for (int rights = 1; rights < 16; rights++) { keys.castling[rights] = splitmix(state); }
+            for (int col = 0; col < 8; col++) { keys.enPassant[col] = splitmix(state); }
+            keys.side = splitmix(state);
+
+            return keys;
+        }
+
+        constexpr Keys KEYS = makeKeys();
+    };
+};
+
+/**
+ * @brief Gets the key of a piece on a square
+ * @param color A const reference to the color of the piece: ChessPiece::BLACK or ChessPiece::WHITE
+ * @param type A const reference to the type of the piece, as a PieceType value. 0 (NONE) has a key of 0.
+ * @param square A const reference to the square of the piece, in [0, SQUARES)
+ * @return The key of the piece
+ */
+constexpr Zobrist::Key Zobrist::piece(const int& color, const int& type, const int& square) {
+    return detail::KEYS.pieces[color][type][square];
+}
+
+/**
+ * @brief Gets the key XORed into the hash while WHITE is to move
+ */
+constexpr Zobrist::Key Zobrist::side() {
+    return detail::KEYS.side;
+}
+
+/**
+ * @brief Gets the key of a set of castling rights
+ * @param rights A const reference to a mask of ChessBoard castling rights, in [0, 16)
+ * @return The key of `rights`. 0 when there are none.
+ */
+constexpr Zobrist::Key Zobrist::castling(const int& rights) {
+    return detail::KEYS.castling[rights];
+}
+
+/**
+ * @brief Gets the key of an en passant square
+ * @param col A const reference to the column of the en passant square, in [0, 8)
+ * @return The key of the column
+ */
+constexpr Zobrist::Key Zobrist::enPassant(const int& col) {
+    return detail::KEYS.enPassant[col];
+}
@@ -0,0 +1,54 @@
+/**
+ * @namespace Zobrist
+ * @brief The random keys hashing a chess position into 64 bits.
+ *
+ * The hash of a position is the XOR of the key of every (color, piece type, square) on the board, the key of the
+ * castling rights, the key of the en passant column (if any) and, when WHITE is to move, the side key. A move changes
+ * a handful of these terms, so ChessBoard::makeMove updates the hash with a few XORs instead of hashing the board again.
+ * The keys are fixed numbers built at compile time, so hashes are stable between runs and can be stored.
+ */
+
+ #pragma once
+ #include <array>
+ #include <cstdint>
+ namespace Zobrist {
+     // Alias for readability
+     typedef uint64_t Key;
+
+     // The number of squares on the chessboard
+     constexpr int SQUARES = 64;
+
+     // The number of piece types (indexed as PieceType, NONE included) and colors (indexed as ChessPiece::Color)
+     constexpr int TYPES = 7;
+     constexpr int COLORS = 2;
+
+     /**
+      * @brief Gets the key of a piece on a square
+      * @param color A const reference to the color of the piece: ChessPiece::BLACK or ChessPiece::WHITE
+      * @param type A const reference to the type of the piece, as a PieceType value. 0 (NONE) has a key of 0.
+      * @param square A const reference to the square of the piece, in [0, SQUARES)
+      * @return The key of the piece
+      */
+     constexpr Key piece(const int& color, const int& type, const int& square);
+
+     /**
+      * @brief Gets the key XORed into the hash while WHITE is to move
+      */
+     constexpr Key side();
+
+     /**
+      * @brief Gets the key of a set of castling rights
+      * @param rights A const reference to a mask of ChessBoard castling rights, in [0, 16)
+      * @return The key of `rights`. 0 when there are none.
+      */
+     constexpr Key castling(const int& rights);
+
+     /**
+      * @brief Gets the key of an en passant square
+      * @param col A const reference to the column of the en passant square, in [0, 8)
+      * @return The key of the column
+      */
+     constexpr Key enPassant(const int& col);
+ };
+
+ #include "Zobrist.cpp"
@@ -1,11 +1,65 @@
+// Searches a position (the starting position by default) and prints the progress of the search.
+//
+// Usage: main [depth] [-t threads] [-H hash_mb] [-m milliseconds] [--fen "<fen>"]
+//      depth       The last iteration to search (8 by default)
+//      -t          The number of search threads (1 by default, 0 for the hardware concurrency)
+//      -H          The size of the transposition table in MB (64 by default)
+//      -m          The time budget in milliseconds (none by default)
+//      --fen       Search a position in Forsyth-Edwards Notation
+
 #include "pieces_module.hpp"
 
 #include "ChessBoard.hpp"
 
 #include "Transform.hpp"
 
+#include "Search.hpp"
+
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <cctype>
+
+
+int main(int argc, char* argv[]) {
+    Search::Limits limits;
+    limits.depth = 8;
+    size_t hashMegabytes = 64;
+    ChessBoard board;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-t" && i + 1 < argc) { limits.threads = std::atoi(argv[++i]); }
+        else if (arg == "-H" && i + 1 < argc) { hashMegabytes = std::strtoull(argv[++i], nullptr, 10); }
+        else if (arg == "-m" && i + 1 < argc) { limits.milliseconds = std::atoll(argv[++i]); }
+        else if (arg == "--fen" && i + 1 < argc) {
+            if (!board.setFromFen(argv[++i])) {
+                std::cerr << "invalid FEN: " << argv[i] << std::endl;
+                return 2;
+            }
+        }
+        else if (!arg.empty() && std::isdigit(static_cast<unsigned char>(arg[0]))) { limits.depth = std::atoi(arg.c_str()); }
+        else {
+            std::cerr << "usage: " << argv[0] << " [depth] [-t threads] [-H hash_mb] [-m milliseconds] [--fen \"<fen>\"]" << std::endl;
+            return 2;
+        }
+    }
+
+    TranspositionTable table(hashMegabytes);
+    Search search(table);
+
+    Search::Info result = search.run(board, limits, [] (const Search::Info& info) {
+        std::cout << "info depth " << info.depth << " score " << Search::scoreToString(info.score) << " nodes " << info.nodes 
+            << " nps " << info.nodesPerSecond << " time " << info.milliseconds << " hashfull " << info.hashfull << " pv";
+        for (const Move& move : info.pv) { std::cout << ' ' << move.toString(); }
+        std::cout << std::endl;
+    });
 
-int main() {
+    if (result.pv.empty()) {
+        std::cout << "bestmove (none)" << std::endl;
+    } else {
+        std::cout << "bestmove " << result.pv.front().toString() << std::endl;
+    }
 
     return 0;
 
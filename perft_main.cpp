@@ -0,0 +1,82 @@
+// Command line driver for Perft.
+//
+// Usage: perft [depth] [-t threads] [-H hash_mb] [-d] [--fen "<fen>"] [--verify]
+//      depth       The number of plies to count (5 by default)
+//      -t          The number of worker threads (1 by default, 0 for the hardware concurrency)
+//      -H          The size of the transposition table in MB (0, no table, by default)
+//      -d          Print the leaf count below each root move (divide)
+//      --fen       Count from a position in Forsyth-Edwards Notation instead of the starting position
+//      --verify    Count every depth from 1 to `depth` of the starting position and compare with the reference counts. 
+//                  Exits with 1 on a mismatch.
+
+#include "Perft.hpp"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cstdlib>
+#include <cctype>
+
+int main(int argc, char* argv[]) {
+    int depth = 5;
+    bool divide = false;
+    bool verify = false;
+    Perft::Options options;
+    ChessBoard board;
+    bool fromFen = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-t" && i + 1 < argc) { options.threads = std::atoi(argv[++i]); }
+        else if (arg == "-H" && i + 1 < argc) { options.hashMegabytes = std::atoi(argv[++i]); }
+        else if (arg == "-d") { divide = true; }
+        else if (arg == "--verify") { verify = true; }
+        else if (arg == "--fen" && i + 1 < argc) {
+            if (!board.setFromFen(argv[++i])) {
+                std::cerr << "invalid FEN: " << argv[i] << std::endl;
+                return 2;
+            }
+            fromFen = true;
+        }
+        else if (!arg.empty() && std::isdigit(static_cast<unsigned char>(arg[0]))) { depth = std::atoi(arg.c_str()); }
+        else {
+            std::cerr << "usage: " << argv[0] << " [depth] [-t threads] [-H hash_mb] [-d] [--fen \"<fen>\"] [--verify]" << std::endl;
+            return 2;
+        }
+    }
+
+    if (verify && fromFen) {
+        std::cerr << "--verify only checks the starting position" << std::endl;
+        return 2;
+    }
+
+    Perft perft(options);
+
+    if (verify) {
+        constexpr int MAX_DEPTH = sizeof(Perft::STARTING_COUNTS) / sizeof(Perft::STARTING_COUNTS[0]) - 1;
+        bool passed = true;
+
+        for (int d = 1; d <= depth && d <= MAX_DEPTH; d++) {
+            Perft::Report report = perft.run(board, d);
+            bool match = report.nodes == Perft::STARTING_COUNTS[d];
+            passed = passed && match;
+
+            std::cout << "depth " << d << ": " << report.nodes << (match ? " ok" : " MISMATCH, expected " + std::to_string(Perft::STARTING_COUNTS[d])) << std::endl;
+        }
+
+        return passed ? 0 : 1;
+    }
+
+    Perft::Report report = perft.run(board, depth);
+
+    if (divide) {
+        for (const Perft::Division& division : report.divisions) { std::cout << division.move.toString() << ": " << division.nodes << std::endl; }
+        std::cout << std::endl;
+    }
+
+    std::cout << "depth " << report.depth << std::endl;
+    std::cout << "nodes " << report.nodes << std::endl;
+    std::cout << "time  " << std::fixed << std::setprecision(3) << report.seconds << " s" << std::endl;
+    std::cout << "nps   " << report.nodesPerSecond() << std::endl;
+
+    return 0;
+}
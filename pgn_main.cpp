@@ -0,0 +1,87 @@
+// Command line driver for PgnPipeline.
+//
+// Usage: pgn <file.pgn> [-t threads] [-q capacity] [-o positions.bin] [-u] [-m megabytes] [-s spill-directory]
+//      -t          The number of parser threads (0, the hardware concurrency, by default)
+//      -q          The most games waiting between two stages of the pipeline (1024 by default)
+//      -o          Write every position of every game to a file of PackedPosition records
+//      -u          Count the distinct positions, a position and its color flip counting as one (see PositionDedup)
+//      -m          The memory the distinct positions may hold before spilling to disk, in MB (1024 by default)
+//      -s          Where the spilled positions are written (the current directory by default)
+
+#include "PgnPipeline.hpp"
+#include "PositionDedup.hpp"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <cstdlib>
+
+int main(int argc, char* argv[]) {
+    PgnPipeline::Options options;
+    PositionDedup::Options dedupOptions;
+    std::string input;
+    std::string output;
+    bool unique = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-t" && i + 1 < argc) { options.threads = std::atoi(argv[++i]); }
+        else if (arg == "-q" && i + 1 < argc) { options.queueCapacity = std::strtoull(argv[++i], nullptr, 10); }
+        else if (arg == "-o" && i + 1 < argc) { output = argv[++i]; }
+        else if (arg == "-u") { unique = true; }
+        else if (arg == "-m" && i + 1 < argc) { dedupOptions.memoryMegabytes = std::strtoull(argv[++i], nullptr, 10); }
+        else if (arg == "-s" && i + 1 < argc) { dedupOptions.spillDirectory = argv[++i]; }
+        else if (input.empty() && !arg.empty() && arg[0] != '-') { input = arg; }
+        else {
+            std::cerr << "usage: " << argv[0] << " <file.pgn> [-t threads] [-q capacity] [-o positions.bin] [-u] [-m megabytes] [-s spill-directory]" << std::endl;
+            return 2;
+        }
+    }
+
+    if (input.empty()) {
+        std::cerr << "usage: " << argv[0] << " <file.pgn> [-t threads] [-q capacity] [-o positions.bin] [-u] [-m megabytes] [-s spill-directory]" << std::endl;
+        return 2;
+    }
+
+    std::ofstream out;
+    if (!output.empty()) {
+        out.open(output, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            std::cerr << "cannot write " << output << std::endl;
+            return 1;
+        }
+    }
+    options.positions = out.is_open() || unique;
+
+    uint64_t positions = 0;
+    PositionDedup dedup(dedupOptions);
+    PgnPipeline pipeline(options);
+    PgnPipeline::Summary summary;
+
+    bool read = pipeline.run(input, [&out, &positions, &dedup, &unique] (const PgnPipeline::Game& game) {
+        positions += game.positions.size();
+        if (unique) {
+            for (const PackedPosition& packed : game.positions) { dedup.add(packed); }
+        }
+        if (out.is_open()) { out.write(reinterpret_cast<const char*>(game.positions.data()), game.positions.size() * sizeof(PackedPosition)); }
+    }, summary);
+
+    if (!read) {
+        std::cerr << "cannot read " << input << std::endl;
+        return 1;
+    }
+
+    std::cout << "games      " << summary.games << std::endl;
+    std::cout << "incomplete " << summary.incomplete << std::endl;
+    std::cout << "plies      " << summary.plies << std::endl;
+    if (options.positions) { std::cout << "positions  " << positions << std::endl; }
+    if (unique) {
+        std::cout << "unique     " << dedup.countUnique() << (dedup.spills() > 0 ? " (" + std::to_string(dedup.spills()) + " runs spilled)" : "") << std::endl;
+        if (dedup.spillFailed()) { std::cerr << "cannot spill to " << dedupOptions.spillDirectory << ": the counts were kept in memory" << std::endl; }
+    }
+    std::cout << "time       " << std::fixed << std::setprecision(3) << summary.seconds << " s" << std::endl;
+    std::cout << "throughput " << std::setprecision(1) << (summary.seconds > 0 ? summary.bytes / summary.seconds / (1 << 20) : 0.0) << " MB/s, "
+        << std::setprecision(0) << (summary.seconds > 0 ? summary.games / summary.seconds : 0.0) << " games/s" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,323 @@
+#include "Attacks.hpp"
+
+namespace Attacks {
+    namespace detail {
+        /**
+         * @brief Builds the attack table of a piece that jumps by fixed steps (a "leaper")
+         *
+         * @param rowSteps A const reference to the row offsets of the steps
+         * @param colSteps A const reference to the column offsets of the steps
+         * @return For every square, the mask of the steps that land on the board
+         */
+        template <size_t N>
+        constexpr std::array<Mask, SQUARES> leaperAttacks(const std::array<int, N>& rowSteps, const std::array<int, N>& colSteps) {
+            std::array<Mask, SQUARES> table{};
+            for (int square = 0; square < SQUARES; square++) {
+                for (size_t i = 0; i < N; i++) {
+                    int row = square / LENGTH + rowSteps[i];
+                    int col = square % LENGTH + colSteps[i];
+                    if (row >= 0 && row < LENGTH && col >= 0 && col < LENGTH) { table[square] |= squareMask(row * LENGTH + col); }
+                }
+            }
+
+            return table;
+        }
+
+        constexpr std::array<Mask, SQUARES> KNIGHT_ATTACKS = leaperAttacks<8>({1, 2, 2, 1, -1, -2, -2, -1}, {2, 1, -1, -2, -2, -1, 1, 2});
+        constexpr std::array<Mask, SQUARES> KING_ATTACKS = leaperAttacks<8>({1, 1, 1, 0, 0, -1, -1, -1}, {-1, 0, 1, -1, 1, -1, 0, 1});
+        constexpr std::array<Mask, SQUARES> PAWN_UP_ATTACKS = leaperAttacks<2>({1, 1}, {-1, 1});
+        constexpr std::array<Mask, SQUARES> PAWN_DOWN_ATTACKS = leaperAttacks<2>({-1, -1}, {-1, 1});
+
+        /**
+         * @brief The magic lookup of one square for one sliding piece.
+         * The occupied squares that can block the piece (`mask`) are hashed by a multiplication with `magic`,
+         * and the top bits of the product index the attack sets of that square.
+         */
+        struct Magic {
+            Mask mask;
+            Mask magic;
+            const Mask* attacks;
+            int shift;
+
+            unsigned index(const Mask& occupied) const { return ((occupied & mask) * magic) >> shift; }
+        };
+
+        /**
+         * @brief The magic lookups of every square, for rooks and bishops, and the attack sets they index
+         */
+        struct MagicTables {
+            std::array<Magic, SQUARES> rook;
+            std::array<Magic, SQUARES> bishop;
+            std::vector<Mask> attacks;
+
+            MagicTables();
+
+            /**
+             * @brief Searches the magic of every square for one sliding piece, and fills in its attack sets
+             * @param magics A (non-const) reference to the lookups to fill in
+             * @param next A (non-const) reference to the first unused entry of `attacks`, moved past the entries used
+             * @param diagonal A const reference to a boolean, true for bishops, false for rooks
+             */
+            void build(std::array<Magic, SQUARES>& magics, size_t& next, const bool& diagonal);
+        };
+
+        /**
+         * @brief Gets the magic tables, building them the first time they are needed (thread-safe)
+         */
+        inline const MagicTables& magicTables() {
+            static const MagicTables tables;
+            return tables;
+        }
+
+        /**
+         * @brief The between and line masks of every pair of squares
+         */
+        struct LineTables {
+            std::array<std::array<Mask, SQUARES>, SQUARES> between;
+            std::array<std::array<Mask, SQUARES>, SQUARES> line;
+
+            LineTables() : between{}, line{} {
+                for (int from = 0; from < SQUARES; from++) {
+                    for (const bool& diagonal : {false, true}) {
+                        Mask reachable = slidingAttacks(from, 0, diagonal);
+
+                        for (int to = 0; to < SQUARES; to++) {
+                            if (!(reachable & squareMask(to))) { continue; }
+
+                            // The two rays that meet are the squares between, the full rays make the line
+                            between[from][to] = slidingAttacks(from, squareMask(to), diagonal) & slidingAttacks(to, squareMask(from), diagonal);
+                            line[from][to] = (slidingAttacks(from, 0, diagonal) & slidingAttacks(to, 0, diagonal)) | squareMask(from) | squareMask(to);
+                        }
+                    }
+                }
+            }
+        };
+
+        /**
+         * @brief Gets the line tables, building them the first time they are needed (thread-safe)
+         */
+        inline const LineTables& lineTables() {
+            static const LineTables tables;
+            return tables;
+        }
+
+        // A small, seeded xorshift generator, so the magic search is the same on every run
+        struct MagicGenerator {
+            uint64_t state;
+
+            uint64_t next() {
+                state ^= state >> 12;
+                state ^= state << 25;
+                state ^= state >> 27;
+                return state * 2685821657736338717ull;
+            }
+
+            // Magics with few set bits are found much faster
+            uint64_t sparse() { return next() & next() & next(); }
+        };
+
+        inline MagicTables::MagicTables() {
+            // 4096 blocker sets at most per rook square, 512 per bishop square
+            attacks.resize(SQUARES * 4096 + SQUARES * 512);
+
+            size_t next = 0;
+            build(rook, next, false);
+            build(bishop, next, true);
+            attacks.resize(next);
+        }
+
+        inline void MagicTables::build(std::array<Magic, SQUARES>& magics, size_t& next, const bool& diagonal) {
+            const Mask rank_edges = 0xFF000000000000FFull;
+            const Mask file_edges = 0x8181818181818181ull;
+
+            // Seeds known to find the magics of each row quickly
+            static const uint64_t seeds[LENGTH] = {728, 10316, 55013, 32803, 12281, 15100, 16645, 255};
+            std::vector<Mask> occupancies;
+            std::vector<Mask> references;
+            std::vector<int> epoch(4096, 0);
+            int attempt = 0;
+
+            for (int square = 0; square < SQUARES; square++) {
+                Mask rank = 0xFFull << (LENGTH * (square / LENGTH));
+                Mask file = 0x0101010101010101ull << (square % LENGTH);
+
+                // Pieces on the last square of a line never block anything further, so the edges are left out
+                Magic& magic = magics[square];
+                Mask edges = (rank_edges & ~rank) | (file_edges & ~file);
+                magic.mask = slidingAttacks(square, 0, diagonal) & ~edges;
+                magic.shift = SQUARES - __builtin_popcountll(magic.mask);
+                magic.attacks = nullptr;
+
+                // Enumerate every subset of the mask (the Carry-Rippler trick)
+                occupancies.clear();
+                references.clear();
+                Mask subset = 0;
+                do {
+                    occupancies.push_back(subset);
+                    references.push_back(slidingAttacks(square, subset, diagonal));
+                    subset = (subset - magic.mask) & magic.mask;
+                } while (subset);
+
+                // Try magics until every subset lands on an entry holding its own attacks (or one with identical attacks)
+                Mask* table = &attacks[next];
+                MagicGenerator generator{seeds[square / LENGTH]};
+                bool found = false;
+                while (!found) {
+                    magic.magic = generator.sparse();
+                    if (__builtin_popcountll((magic.mask * magic.magic) >> 56) < 6) { continue; }
+
+                    attempt++;
+                    found = true;
+                    for (size_t i = 0; i < occupancies.size() && found; i++) {
+                        unsigned index = magic.index(occupancies[i]);
+                        if (epoch[index] < attempt) {
+                            epoch[index] = attempt;
+                            table[index] = references[i];
+                        } else if (table[index] != references[i]) {
+                            found = false;
+                        }
+                    }
+                }
+
+                magic.attacks = table;
+                next += occupancies.size();
+            }
+        }
+    }
+}
+
+/**
+ * @brief Lists the squares of a mask
+ * @param mask A const reference to a Mask
+ * @return A SquareList holding every square set in `mask`, lowest first
+ */
+inline Attacks::SquareList Attacks::toSquareList(const Mask& mask) {
+    SquareList list;
+    list.size = 0;
+
+    for (Mask remaining = mask; remaining; remaining &= remaining - 1) {
+        list.squares[list.size++] = __builtin_ctzll(remaining);
+    }
+
+    return list;
+}
+
+/**
+ * @brief Builds the magic & line tables now, instead of on their first lookup
+ * @note Safe to call more than once, and from several threads.
+ */
+inline void Attacks::init() {
+    detail::magicTables();
+    detail::lineTables();
+}
+
+/**
+ * @brief Gets the squares a knight attacks
+ * @param square A const reference to the square of the knight
+ * @return The squares an L-shape move away from `square`
+ */
+inline Attacks::Mask Attacks::knightAttacks(const int& square) {
+    return detail::KNIGHT_ATTACKS[square];
+}
+
+/**
+ * @brief Gets the squares a king attacks
+ * @param square A const reference to the square of the king
+ * @return The (up to 8) squares adjacent to `square`
+ */
+inline Attacks::Mask Attacks::kingAttacks(const int& square) {
+    return detail::KING_ATTACKS[square];
+}
+
+/**
+ * @brief Gets the squares a pawn attacks (captures on)
+ * @param square A const reference to the square of the pawn
+ * @param movingUp A const reference to a boolean, true if the pawn moves towards higher rows
+ * @return The (up to 2) squares one row forward and one column to either side
+ */
+inline Attacks::Mask Attacks::pawnAttacks(const int& square, const bool& movingUp) {
+    return movingUp ? detail::PAWN_UP_ATTACKS[square] : detail::PAWN_DOWN_ATTACKS[square];
+}
+
+/**
+ * @brief Gets the squares a rook attacks
+ * @param square A const reference to the square of the rook
+ * @param occupied A const reference to the mask of every occupied square
+ * @return Every square along the rook's 4 lines, up to and including the first occupied square of each
+ */
+inline Attacks::Mask Attacks::rookAttacks(const int& square, const Mask& occupied) {
+    const detail::Magic& magic = detail::magicTables().rook[square];
+    return magic.attacks[magic.index(occupied)];
+}
+
+/**
+ * @brief Gets the squares a bishop attacks
+ * @param square A const reference to the square of the bishop
+ * @param occupied A const reference to the mask of every occupied square
+ * @return Every square along the bishop's 4 diagonals, up to and including the first occupied square of each
+ */
+inline Attacks::Mask Attacks::bishopAttacks(const int& square, const Mask& occupied) {
+    const detail::Magic& magic = detail::magicTables().bishop[square];
+    return magic.attacks[magic.index(occupied)];
+}
+
+/**
+ * @brief Gets the squares a queen attacks
+ * @param square A const reference to the square of the queen
+ * @param occupied A const reference to the mask of every occupied square
+ * @return The union of the rook and bishop attacks from `square`
+ */
+inline Attacks::Mask Attacks::queenAttacks(const int& square, const Mask& occupied) {
+    return rookAttacks(square, occupied) | bishopAttacks(square, occupied);
+}
+
+/**
+ * @brief Gets the squares strictly between two squares on a shared line
+ * @param from A const reference to a square
+ * @param to A const reference to a square
+ * @return The squares between `from` and `to` if they share a row, column or diagonal. 0 otherwise.
+ */
+inline Attacks::Mask Attacks::between(const int& from, const int& to) {
+    return detail::lineTables().between[from][to];
+}
+
+/**
+ * @brief Gets the full line through two squares
+ * @param from A const reference to a square
+ * @param to A const reference to a different square
+ * @return Every square of the row, column or diagonal through `from` and `to` (edge to edge). 0 if they share none.
+ */
+inline Attacks::Mask Attacks::line(const int& from, const int& to) {
+    return detail::lineTables().line[from][to];
+}
+
+/**
+ * @brief Computes the squares a sliding piece attacks by walking its lines one square at a time.
+ * @note This is the slow reference used to build the magic tables.
+ *
+ * @param square A const reference to the square of the piece
+ * @param occupied A const reference to the mask of every occupied square
+ * @param diagonal A const reference to a boolean, true for bishop lines, false for rook lines
+ * @return Every square along the piece's 4 lines, up to and including the first occupied square of each
+ */
+inline Attacks::Mask Attacks::slidingAttacks(const int& square, const Mask& occupied, const bool& diagonal) {
+    static const int rook_steps[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+    static const int bishop_steps[4][2] = {{1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+    const int (&steps)[4][2] = diagonal ? bishop_steps : rook_steps;
+
+    Mask attacks = 0;
+    for (const auto& step : steps) {
+        int row = square / LENGTH + step[0];
+        int col = square % LENGTH + step[1];
+
+        while (row >= 0 && row < LENGTH && col >= 0 && col < LENGTH) {
+            attacks |= squareMask(row * LENGTH + col);
+            if (occupied & squareMask(row * LENGTH + col)) { break; }
+
+            row += step[0];
+            col += step[1];
+        }
+    }
+
+    return attacks;
+}
@@ -0,0 +1,131 @@
+/**
+ * @namespace Attacks
+ * @brief Precomputed attack sets of every chess piece, as 64-bit masks.
+ *
+ * Bit (8 * row + col) of a Mask stands for the cell (row, col), the same indexing as Mailbox squares and Transform::PackedBoard.
+ * Knight, king and pawn attacks are constant tables built at compile time. Rook and bishop attacks are looked up
+ * in "fancy" magic bitboard tables (one multiply, shift and load per query, no PEXT instruction needed).
+ * The magic numbers are searched with a seeded generator the first time a sliding piece is looked up.
+ */
+
+ #pragma once
+ #include <array>
+ #include <vector>
+ #include <cstdint>
+ #include <cstddef>
+ namespace Attacks {
+     // A set of squares, one bit per square
+     typedef uint64_t Mask;
+
+     // The number of rows & columns on the chessboard
+     constexpr int LENGTH = 8;
+
+     // The number of squares on the chessboard
+     constexpr int SQUARES = LENGTH * LENGTH;
+
+     /**
+      * @brief Gets the mask of a single square
+      * @param square A const reference to a square index in [0, SQUARES)
+      * @return A Mask with only the bit of `square` set
+      */
+     constexpr Mask squareMask(const int& square) { return 1ull << square; }
+
+     /**
+      * @brief A fixed-capacity list of squares (no heap allocation), in increasing square order
+      */
+     struct SquareList {
+         std::array<uint8_t, SQUARES> squares;
+         int size;
+
+         const uint8_t* begin() const { return squares.data(); }
+         const uint8_t* end() const { return squares.data() + size; }
+     };
+
+     /**
+      * @brief Lists the squares of a mask
+      * @param mask A const reference to a Mask
+      * @return A SquareList holding every square set in `mask`, lowest first
+      */
+     inline SquareList toSquareList(const Mask& mask);
+
+     /**
+      * @brief Builds the magic & line tables now, instead of on their first lookup
+      * @note Safe to call more than once, and from several threads.
+      */
+     inline void init();
+
+     /**
+      * @brief Gets the squares a knight attacks
+      * @param square A const reference to the square of the knight
+      * @return The squares an L-shape move away from `square`
+      */
+     inline Mask knightAttacks(const int& square);
+
+     /**
+      * @brief Gets the squares a king attacks
+      * @param square A const reference to the square of the king
+      * @return The (up to 8) squares adjacent to `square`
+      */
+     inline Mask kingAttacks(const int& square);
+
+     /**
+      * @brief Gets the squares a pawn attacks (captures on)
+      * @param square A const reference to the square of the pawn
+      * @param movingUp A const reference to a boolean, true if the pawn moves towards higher rows
+      * @return The (up to 2) squares one row forward and one column to either side
+      */
+     inline Mask pawnAttacks(const int& square, const bool& movingUp);
+
+     /**
+      * @brief Gets the squares a rook attacks
+      * @param square A const reference to the square of the rook
+      * @param occupied A const reference to the mask of every occupied square
+      * @return Every square along the rook's 4 lines, up to and including the first occupied square of each
+      */
+     inline Mask rookAttacks(const int& square, const Mask& occupied);
+
+     /**
+      * @brief Gets the squares a bishop attacks
+      * @param square A const reference to the square of the bishop
+      * @param occupied A const reference to the mask of every occupied square
+      * @return Every square along the bishop's 4 diagonals, up to and including the first occupied square of each
+      */
+     inline Mask bishopAttacks(const int& square, const Mask& occupied);
+
+     /**
+      * @brief Gets the squares a queen attacks
+      * @param square A const reference to the square of the queen
+      * @param occupied A const reference to the mask of every occupied square
+      * @return The union of the rook and bishop attacks from `square`
+      */
+     inline Mask queenAttacks(const int& square, const Mask& occupied);
+
+     /**
+      * @brief Gets the squares strictly between two squares on a shared line
+      * @param from A const reference to a square
+      * @param to A const reference to a square
+      * @return The squares between `from` and `to` if they share a row, column or diagonal. 0 otherwise.
+      */
+     inline Mask between(const int& from, const int& to);
+
+     /**
+      * @brief Gets the full line through two squares
+      * @param from A const reference to a square
+      * @param to A const reference to a different square
+      * @return Every square of the row, column or diagonal through `from` and `to` (edge to edge). 0 if they share none.
+      */
+     inline Mask line(const int& from, const int& to);
+
+     /**
+      * @brief Computes the squares a sliding piece attacks by walking its lines one square at a time.
+      * @note This is the slow reference used to build the magic tables.
+      *
+      * @param square A const reference to the square of the piece
+      * @param occupied A const reference to the mask of every occupied square
+      * @param diagonal A const reference to a boolean, true for bishop lines, false for rook lines
+      * @return Every square along the piece's 4 lines, up to and including the first occupied square of each
+      */
+     inline Mask slidingAttacks(const int& square, const Mask& occupied, const bool& diagonal);
+ };
+
+ #include "Attacks.cpp"
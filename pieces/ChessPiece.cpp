@@ -1,4 +1,34 @@
 #include "ChessPiece.hpp"
+#include "MoveRules.hpp"
+#include <array>
+#include <atomic>
+#include <mutex>
+
+namespace {
+    /**
+     * @brief The interned color names. Names are only ever appended: a reader that sees `count` 
+     *      may read every name below it without locking, and the names never move.
+     */
+    struct ColorRegistry {
+        std::array<std::string, ChessPiece::MAX_COLORS> names;
+        std::atomic<int> count;
+        std::mutex lock;
+
+        ColorRegistry() : names{}, count{0} {
+            names[ChessPiece::BLACK] = "BLACK";
+            names[ChessPiece::WHITE] = "WHITE";
+            count.store(2, std::memory_order_release);
+        }
+    };
+
+    ColorRegistry& colorRegistry() {
+        static ColorRegistry registry;
+        return registry;
+    }
+
+    // The names of the piece types, indexed by PieceType
+    const std::array<std::string, 7> TYPE_NAMES = {"NONE", "PAWN", "KNIGHT", "BISHOP", "ROOK", "QUEEN", "KING"};
+}
 
 /**
  * @brief Default Constructor : All values 
@@ -9,7 +39,7 @@
  * Default type: "NONE"
  * Default size: 0
  */
-ChessPiece::ChessPiece() : color_{"BLACK"}, row_{-1}, column_{-1}, movingUp_{false}, piece_size_{0}, type_{"NULL"}, has_moved_{false} {} 
+ChessPiece::ChessPiece() : color_{BLACK}, row_{-1}, column_{-1}, movingUp_{false}, piece_size_{0}, type_{PieceType::NONE}, has_moved_{false} {} 
 
 /**
 * @brief Parameterized constructor.
@@ -21,10 +51,10 @@ ChessPiece::ChessPiece() : color_{"BLACK"}, row_{-1}, column_{-1}, movingUp_{fal
 * @post : The private members are set to the values of the corresponding parameters. 
 *   If either of row or col are out-of-bounds and set to -1, the other is also set to -1 (regardless of being in-bounds or not).
 *   Default piece_size: 0
-*   Default type: "NONE"
+*   Default type: PieceType::NONE
 */
-ChessPiece::ChessPiece(const std::string& color, const int& row, const int& col, const bool& movingUp, const int& size, const std::string& type) :
-    color_{"BLACK"}, row_{-1}, column_{-1}, movingUp_{movingUp}, piece_size_{size}, type_{type}, has_moved_{false} {
+ChessPiece::ChessPiece(const std::string& color, const int& row, const int& col, const bool& movingUp, const int& size, const PieceType& type) :
+    color_{BLACK}, row_{-1}, column_{-1}, movingUp_{movingUp}, piece_size_{static_cast<int8_t>(size)}, type_{type}, has_moved_{false} {
         // Check for fully alphabetical string & override "BLACK" if valid color
         setColor(color);
         
@@ -34,12 +64,74 @@ ChessPiece::ChessPiece(const std::string& color, const int& row, const int& col,
         if (row_ != -1) { setColumn(col); }
     }
 
+/**
+ * @brief Finds the id of a color name, registering the name the first time it is seen. Safe to call from several threads.
+ * @pre The name is uppercase & alphabetic
+ * @param name A const reference to the name of the color
+ * @return The id of the color, or BLACK if MAX_COLORS names are already registered
+ * @note BLACK and WHITE are always registered, with the ids BLACK and WHITE.
+ */
+ChessPiece::Color ChessPiece::internColor(const std::string& name) {
+    ColorRegistry& registry = colorRegistry();
+
+    // Most lookups find a registered name, without locking
+    int count = registry.count.load(std::memory_order_acquire);
+    for (int i = 0; i < count; i++) {
+        if (registry.names[i] == name) { return i; }
+    }
+
+    std::lock_guard<std::mutex> guard(registry.lock);
+
+    // Another thread may have registered names since the first scan
+    int latest = registry.count.load(std::memory_order_relaxed);
+    for (int i = count; i < latest; i++) {
+        if (registry.names[i] == name) { return i; }
+    }
+
+    if (latest == MAX_COLORS) { return BLACK; }
+
+    registry.names[latest] = name;
+    registry.count.store(latest + 1, std::memory_order_release);
+    return latest;
+}
+
+/**
+ * @brief Gets the name of a color
+ * @param color A const reference to the id of a color returned by internColor
+ * @return A const reference to the interned name, which lives for the rest of the program
+ */
+const std::string& ChessPiece::colorName(const Color& color) {
+    return colorRegistry().names[color];
+}
+
+/**
+ * @brief Gets the name of a piece type, for display & I/O
+ * @param type A const reference to a PieceType
+ * @return A const reference to the uppercase name of the type ("PAWN", "KNIGHT", ..., or "NONE")
+ */
+const std::string& ChessPiece::typeName(const PieceType& type) {
+    return TYPE_NAMES[static_cast<int>(type)];
+}
+
+/**
+ * @brief Finds the piece type with a given name
+ * @param name A const reference to an uppercase name ("PAWN", "KNIGHT", ...)
+ * @return The PieceType with that name, PieceType::NONE if there is none
+ */
+PieceType ChessPiece::typeFromName(const std::string& name) {
+    for (size_t i = 1; i < TYPE_NAMES.size(); i++) {
+        if (TYPE_NAMES[i] == name) { return static_cast<PieceType>(i); }
+    }
+
+    return PieceType::NONE;
+}
+
 /**
  * @brief Gets the color of the chess piece.
- * @return The string value stored in color_
+ * @return A const reference to the interned name of the color stored in color_
  */
-std::string ChessPiece::getColor() const { 
-    return color_; 
+const std::string& ChessPiece::getColor() const { 
+    return colorName(color_); 
 }
 
 /**
@@ -47,30 +139,29 @@ std::string ChessPiece::getColor() const {
  * @param color A const string reference, representing the color to set the piece to. 
  *     If the string contains non-alphabetic characters, the value is not set (ie. nothing happens)
  *     If the string is alphabetic, then all characters are converted and stored in uppercase
- * @post The color_ member variable is updated to the parameter value in uppercase
+ * @post The color_ member variable is updated to the id of the parameter value in uppercase
  * @return True if the color was set sucessfully. False otherwise.
  */
 bool ChessPiece::setColor(const std::string& color) {
-    std::string uppercase = "";
-    for (size_t i = 0; i < color.size() && std::isalpha(color[i]); i++) {
-        uppercase += std::toupper(color[i]);
-    } 
-
-    // If all param characters are successfully converted to uppercase, we use it
-    if (uppercase.size() == color.size()) { 
-        color_ = std::move(uppercase); 
+    bool is_uppercase = true;
+    for (const char& c : color) {
+        if (!std::isalpha(static_cast<unsigned char>(c))) { return false; }
+        is_uppercase = is_uppercase && std::isupper(static_cast<unsigned char>(c));
+    }
+
+    // Names that are already uppercase (such as "BLACK" and "WHITE") are looked up as-is, without building a copy
+    if (is_uppercase) {
+        color_ = internColor(color);
         return true;
     }
 
-    return false;
-}
+    std::string uppercase = color;
+    for (char& c : uppercase) {
+        c = std::toupper(static_cast<unsigned char>(c));
+    }
 
-/**
- * @brief Gets the row position of the chess piece.
- * @return The integer value stored in row_
- */
-int ChessPiece::getRow() const {
-    return row_;
+    color_ = internColor(uppercase);
+    return true;
 }
 
 /**
@@ -88,14 +179,6 @@ void ChessPiece::setRow(const int& row) {
     row_ = row;
 }
 
-/**
- * @brief Gets the column position of the chess piece.
- * @return The integer value stored in column_
- */
-int ChessPiece::getColumn() const {
-    return column_;
-}
-
 /**
  * @brief Sets the column position of the chess piece 
  * @param row A const reference to an integer representing the new column of the piece 
@@ -111,14 +194,6 @@ void ChessPiece::setColumn(const int& column) {
     column_ = column;
 }
 
-/**
- * @brief Gets the value of the flag for if a chess piece is moving up
- * @return The boolean value stored in movingUp_
- */
-bool ChessPiece::isMovingUp() const {
-    return movingUp_;
-}
-
 /**
  * @brief Sets the movingUp flag of the chess piece 
  * @param flag A const reference to an boolean representing whether the piece is now moving up or not
@@ -137,11 +212,11 @@ void ChessPiece::setMovingUp(const bool& flag) {
      */
 void ChessPiece::display() const {
     if (row_ == -1 || column_ == -1) {
-        std::cout << color_ << " piece is not on the board" << std::endl;
+        std::cout << getColor() << " piece is not on the board" << std::endl;
         return; 
     }
 
-    std::cout << color_ << " piece at " << "(" << row_ << ", " << column_ << ") is moving " 
+    std::cout << getColor() << " piece at " << "(" << getRow() << ", " << getColumn() << ") is moving " 
         << (movingUp_ ? "UP" : "DOWN") << std::endl;
 }
 
@@ -153,10 +228,11 @@ int ChessPiece::size() const {
 }
 
 /**
-* @brief Getter for the type_ data member
-*/
-std::string ChessPiece::getType() const {
-    return type_;
+ * @brief Gets the name of the type of the chess piece, for display & I/O
+ * @return A const reference to the name of the type stored in type_
+ */
+const std::string& ChessPiece::getType() const {
+    return typeName(type_);
 }
 
 /**
@@ -170,7 +246,7 @@ void ChessPiece::setSize(const int& size)  {
 /**
  * @brief Setter for the type_ data member
  */
-void ChessPiece::setType(const std::string& type) {
+void ChessPiece::setType(const PieceType& type) {
     type_ = type;
 }
 
@@ -182,9 +258,21 @@ void ChessPiece::flagMoved() {
 }
 
 /**
-* @brief Determines whether a ChessPiece has moved on the board
-* @return The value stored in the `has_moved_` member
-*/
-bool ChessPiece::hasMoved() const {
-    return has_moved_;
-}
\ No newline at end of file
+ * @brief Finds every position the ChessPiece can move to on the board, in one call
+ * 
+ * @param board A const reference to the 8x8 board the piece is on
+ * @return A mask with bit (target_row * BOARD_LENGTH + target_col) set exactly when canMove(target_row, target_col, board) is true
+ */
+Attacks::Mask ChessPiece::reachableSquares(const std::vector<std::vector<ChessPiece*>>& board) const {
+    return MoveRules::reachableSquares(MoveRules::moverOf(*this), MoveRules::PieceGrid(board));
+}
+
+/**
+ * @brief Lists every position the ChessPiece can move to on the board, in one call
+ * 
+ * @param board A const reference to the 8x8 board the piece is on
+ * @return A fixed-capacity list of the squares (target_row * BOARD_LENGTH + target_col) set in reachableSquares(board)
+ */
+Attacks::SquareList ChessPiece::reachableSquareList(const std::vector<std::vector<ChessPiece*>>& board) const {
+    return Attacks::toSquareList(reachableSquares(board));
+}
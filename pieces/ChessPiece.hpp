@@ -8,14 +8,35 @@
 #pragma once
 #include <iostream>
 #include <cctype>
+#include <cstdint>
+#include <string>
 #include <vector>
+#include "Attacks.hpp"
+
+/**
+ * @brief The type of a chess piece. NONE marks a piece that is not one of the 6 chess pieces.
+ */
+enum class PieceType : uint8_t { NONE, PAWN, KNIGHT, BISHOP, ROOK, QUEEN, KING };
 
 class ChessPiece {
+   public:
+      /**
+       * @brief Identifies a color. Every color name is interned once (see internColor), so pieces store 
+       *    and compare a single byte, and getColor hands out the interned name without copying it.
+       */
+      typedef uint8_t Color;
+
+      static constexpr Color BLACK = 0;
+      static constexpr Color WHITE = 1;
+
+      // The number of distinct colors that can be interned
+      static constexpr int MAX_COLORS = 256;
+
    protected:
       static const int BOARD_LENGTH = 8; // A constant value representing the number of rows & columns on the chessboard
 
    private:
-      std::string color_;  // An uppercase, alphabetic string representing the color of the chess piece.
+      Color color_;  // The id of the interned, uppercase, alphabetic name of the color of the chess piece.
 
       /** Consider an 8x8 grid with the following indexing:
          *  7 | * * * * * * * *
@@ -31,11 +52,11 @@ class ChessPiece {
       */
 
 
-      int row_;               // An integer corresponding to the row position of the chess piece
-      int column_;            // An integer corresponding to the column position of the chess piece
+      int8_t row_;            // An integer corresponding to the row position of the chess piece
+      int8_t column_;         // An integer corresponding to the column position of the chess piece
       bool movingUp_;         // A boolean representing whether the piece is moving up the board (in reference to the visual above)
-      int piece_size_;        // An integer representing the size of the current chess piece
-      std::string type_;      // A string representing the type of the current chess piece
+      int8_t piece_size_;     // An integer representing the size of the current chess piece
+      PieceType type_;        // The type of the current chess piece
       bool has_moved_;
 
    protected:
@@ -47,7 +68,7 @@ class ChessPiece {
       /**
        * @brief Setter for the type_ data member
        */
-      void setType(const std::string& type);
+      void setType(const PieceType& type);
 
    public:
 
@@ -73,23 +94,84 @@ class ChessPiece {
     * @post : The private members are set to the values of the corresponding parameters. 
     *   If either of row or col are out-of-bounds and set to -1, the other is also set to -1 (regardless of being in-bounds or not).
     *   Default piece_size: 0
+    *   Default type: PieceType::NONE
+    */
+   ChessPiece(const std::string& color, const int& row = -1, const int& col = -1, const bool& movingUp = false, const int& size = 0, const PieceType& type = PieceType::NONE);
+
+   // =============== Colors & Types ===============
+
+   /**
+    * @brief Finds the id of a color name, registering the name the first time it is seen. Safe to call from several threads.
+    * @pre The name is uppercase & alphabetic
+    * @param name A const reference to the name of the color
+    * @return The id of the color, or BLACK if MAX_COLORS names are already registered
+    * @note BLACK and WHITE are always registered, with the ids BLACK and WHITE.
+    */
+   static Color internColor(const std::string& name);
+
+   /**
+    * @brief Gets the name of a color
+    * @param color A const reference to the id of a color returned by internColor
+    * @return A const reference to the interned name, which lives for the rest of the program
+    */
+   static const std::string& colorName(const Color& color);
+
+   /**
+    * @brief Gets the name of a piece type, for display & I/O
+    * @param type A const reference to a PieceType
+    * @return A const reference to the uppercase name of the type ("PAWN", "KNIGHT", ..., or "NONE")
     */
-   ChessPiece(const std::string& color, const int& row = -1, const int& col = -1, const bool& movingUp = false, const int& size = 0, const std::string& type="NONE");
+   static const std::string& typeName(const PieceType& type);
+
+   /**
+    * @brief Finds the piece type with a given name
+    * @param name A const reference to an uppercase name ("PAWN", "KNIGHT", ...)
+    * @return The PieceType with that name, PieceType::NONE if there is none
+    */
+   static PieceType typeFromName(const std::string& name);
+
+   /**
+    * @brief Destructor. Virtual, since boards own their pieces as ChessPiece* and delete them through it.
+    */
+   virtual ~ChessPiece() = default;
+
+   /**
+    * @brief Gets the size (material value) every piece of a type is built with
+    * @param type A const reference to a PieceType
+    * @return 1 for pawns, 3 for knights & bishops, 2 for rooks, 4 for queens & kings, 0 for NONE
+    */
+   static constexpr int sizeOf(const PieceType& type) {
+      switch (type) {
+         case PieceType::PAWN:   return 1;
+         case PieceType::KNIGHT: return 3;
+         case PieceType::BISHOP: return 3;
+         case PieceType::ROOK:   return 2;
+         case PieceType::QUEEN:  return 4;
+         case PieceType::KING:   return 4;
+         default:                return 0;
+      }
+   }
 
    // =============== Getters and Setters ===============
 
    /**
     * @brief Gets the color of the chess piece.
-    * @return The value stored in color_
+    * @return A const reference to the interned name of the color stored in color_
     */
-   std::string getColor() const;
+   const std::string& getColor() const;
+
+   /**
+    * @brief Gets the color of the chess piece, as an id.
+    * @return The value stored in color_. Two pieces share a color exactly when they share a color id.
+    */
+   Color getColorId() const;
 
    /**
     * @brief Sets the color of the chess piece.
     * @param color A const string reference, representing the color to set the piece to. 
     *     If the string contains non-alphabetic characters, the value is not set (ie. nothing happens)
     *     If the string is alphabetic, then all characters are converted and stored in uppercase
-    * @post The color_ member variable is updated to the parameter value in uppercase
+    * @post The color_ member variable is updated to the id of the parameter value in uppercase
     * @return True if the color was set. False otherwise.
     */
    bool setColor(const std::string& color);
@@ -147,10 +229,16 @@ class ChessPiece {
     */
    int size() const;
 
+   /**
+    * @brief Gets the name of the type of the chess piece, for display & I/O
+    * @return A const reference to the name of the type stored in type_
+    */
+   const std::string& getType() const;
+
    /**
     * @brief Getter for the type_ data member
     */
-   std::string getType() const;
+   PieceType getPieceType() const;
    
    /**
      * @brief Determines whether the ChessPiece can move to the specified target position on the board.
@@ -161,6 +249,22 @@ class ChessPiece {
      */
    virtual bool canMove(const int& target_row, const int& target_col, const std::vector<std::vector<ChessPiece*>>& board) const = 0;
 
+   /**
+     * @brief Finds every position the ChessPiece can move to on the board, in one call
+     * 
+     * @param board A const reference to the 8x8 board the piece is on
+     * @return A mask with bit (target_row * BOARD_LENGTH + target_col) set exactly when canMove(target_row, target_col, board) is true
+     */
+   Attacks::Mask reachableSquares(const std::vector<std::vector<ChessPiece*>>& board) const;
+
+   /**
+     * @brief Lists every position the ChessPiece can move to on the board, in one call
+     * 
+     * @param board A const reference to the 8x8 board the piece is on
+     * @return A fixed-capacity list of the squares (target_row * BOARD_LENGTH + target_col) set in reachableSquares(board)
+     */
+   Attacks::SquareList reachableSquareList(const std::vector<std::vector<ChessPiece*>>& board) const;
+
    /**
     * @brief Determines whether a ChessPiece has moved on the board
     * @return The value stored in the `has_moved_` member
@@ -171,4 +275,53 @@ class ChessPiece {
     * @brief Sets a ChessPiece's `has_moved_` member to true
     */
    void flagMoved();
-};
\ No newline at end of file
+};
+
+// The accessors read by the move rules are defined here, so they can be inlined (see MoveRules.hpp)
+
+/**
+ * @brief Gets the color of the chess piece, as an id.
+ * @return The value stored in color_. Two pieces share a color exactly when they share a color id.
+ */
+inline ChessPiece::Color ChessPiece::getColorId() const {
+    return color_;
+}
+
+/**
+ * @brief Gets the row position of the chess piece.
+ * @return The integer value stored in row_
+ */
+inline int ChessPiece::getRow() const {
+    return row_;
+}
+
+/**
+ * @brief Gets the column position of the chess piece.
+ * @return The integer value stored in column_
+ */
+inline int ChessPiece::getColumn() const {
+    return column_;
+}
+
+/**
+ * @brief Gets the value of the flag for if a chess piece is moving up
+ * @return The boolean value stored in movingUp_
+ */
+inline bool ChessPiece::isMovingUp() const {
+    return movingUp_;
+}
+
+/**
+* @brief Getter for the type_ data member
+*/
+inline PieceType ChessPiece::getPieceType() const {
+    return type_;
+}
+
+/**
+* @brief Determines whether a ChessPiece has moved on the board
+* @return The value stored in the `has_moved_` member
+*/
+inline bool ChessPiece::hasMoved() const {
+    return has_moved_;
+}
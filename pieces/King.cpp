@@ -1,10 +1,11 @@
 #include "King.hpp"
+#include "MoveRules.hpp"
 
 /**
  * @brief Default Constructor.
  * @post Sets piece_size_ to 4 and type to "KING"
  */
-King::King() : ChessPiece() { setSize(4); setType("KING"); }
+King::King() : ChessPiece() { setSize(sizeOf(PieceType::KING)); setType(PieceType::KING); }
 
 /**
  * @brief Parameterized constructor.
@@ -14,16 +15,12 @@ King::King() : ChessPiece() { setSize(4); setType("KING"); }
  * @param movingUp: Flag indicating whether the King is moving up.
  */
 King::King(const std::string& color, const int& row, const int& col, const bool& movingUp)
-    : ChessPiece(color, row, col, movingUp, 4, "KING") {}
+    : ChessPiece(color, row, col, movingUp, sizeOf(PieceType::KING), PieceType::KING) {}
 
+/**
+ * @brief Determines whether the King can move to the target position. 
+ * @note A thin shim over MoveRules::kingCanMove, which callers that know the piece type can call without a virtual call.
+ */
 bool King::canMove(const int& target_row, const int& target_col, const std::vector<std::vector<ChessPiece*>>& board) const {
-    // Check for bounds and on_board
-    if (getRow() == -1 || getColumn() == -1) { return false; } 
-    if (target_row < 0 || target_row >= BOARD_LENGTH || target_col < 0 || target_col >= BOARD_LENGTH) { return false; } 
-
-    ChessPiece* target_piece = board[target_row][target_col];
-    if (target_piece && target_piece->getColor() == getColor()) { return false; }
-
-    return (target_row != getRow() || target_col != getColumn() ) &&  
-        (std::abs(target_row - getRow()) <= 1 && std::abs(target_col - getColumn()) <= 1);
-}
\ No newline at end of file
+    return MoveRules::kingCanMove(MoveRules::moverOf(*this), target_row, target_col, MoveRules::PieceGrid(board));
+}
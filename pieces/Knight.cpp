@@ -1,10 +1,11 @@
 #include "Knight.hpp"
+#include "MoveRules.hpp"
 
 /**
  * @brief Default Constructor.
  * @post Sets piece_size_ to 3 and type to "KNIGHT"
  */
-Knight::Knight() : ChessPiece() { setSize(3); setType("KNIGHT"); }
+Knight::Knight() : ChessPiece() { setSize(sizeOf(PieceType::KNIGHT)); setType(PieceType::KNIGHT); }
 
 /**
  * @brief Parameterized constructor.
@@ -14,21 +15,12 @@ Knight::Knight() : ChessPiece() { setSize(3); setType("KNIGHT"); }
  * @param movingUp: Flag indicating whether the Knight is moving up.
  */
 Knight::Knight(const std::string& color, const int& row, const int& col, const bool& movingUp)
-    : ChessPiece(color, row, col, movingUp, 3, "KNIGHT") {}
+    : ChessPiece(color, row, col, movingUp, sizeOf(PieceType::KNIGHT), PieceType::KNIGHT) {}
 
+/**
+ * @brief Determines whether the Knight can move to the target position. 
+ * @note A thin shim over MoveRules::knightCanMove, which callers that know the piece type can call without a virtual call.
+ */
 bool Knight::canMove(const int& target_row, const int& target_col, const std::vector<std::vector<ChessPiece*>>& board) const {
-    // Not on the board
-    if (getRow() == -1 || getColumn() == -1) { return false; }
-
-    // Out of bounds target
-    if (target_row < 0 || target_row >= BOARD_LENGTH || target_col < 0 || target_col >= BOARD_LENGTH) { return false; }
-
-    ChessPiece* target_piece = board[target_row][target_col];
-    if (target_piece && target_piece->getColor() == getColor()) { return false; }
-
-    int abs_dx = std::abs(getRow() - target_row);
-    int abs_dy = std::abs(getColumn() - target_col);
-
-    // Check for an L-shape move pattern
-    return (abs_dx == 1 && abs_dy == 2) || (abs_dx == 2 && abs_dy == 1);
-}
\ No newline at end of file
+    return MoveRules::knightCanMove(MoveRules::moverOf(*this), target_row, target_col, MoveRules::PieceGrid(board));
+}
@@ -0,0 +1,176 @@
+#include "MoveRules.hpp"
+
+/**
+ * @brief Reads the state of a ChessPiece
+ * @param piece A const reference to a ChessPiece
+ * @return The Mover describing `piece`
+ */
+inline MoveRules::Mover MoveRules::moverOf(const ChessPiece& piece) {
+    return Mover{piece.getPieceType(), piece.getColorId(), piece.getRow(), piece.getColumn(), piece.isMovingUp(), piece.hasMoved()};
+}
+
+/**
+ * @brief Checks the conditions shared by every piece: the piece is on the board, and the target is on the board and not held by a friendly piece
+ * @return True if the move passes these checks. False otherwise.
+ */
+template <typename Board>
+bool MoveRules::isOpenTarget(const Mover& mover, const int& target_row, const int& target_col, const Board& board) {
+    // Not on the board
+    if (mover.row == -1 || mover.col == -1) { return false; }
+
+    // Out of bounds target
+    if (target_row < 0 || target_row >= board.length() || target_col < 0 || target_col >= board.length()) { return false; }
+
+    return board.colorAt(target_row, target_col) != mover.color;
+}
+
+/**
+ * @brief Determines whether a pawn can move to the target position: one row forward onto an empty cell
+ *      (or two, if it has not moved yet), or one row forward diagonally onto an enemy piece
+ */
+template <typename Board>
+bool MoveRules::pawnCanMove(const Mover& mover, const int& target_row, const int& target_col, const Board& board) {
+    if (!isOpenTarget(mover, target_row, target_col, board)) { return false; }
+
+    bool target_empty = board.colorAt(target_row, target_col) == EMPTY;
+    int direction = mover.movingUp ? 1 : -1;
+
+    bool can_move_straight =
+        (target_empty && mover.col == target_col) && // Is moving straight (and there is no obstructing piece)
+        ((mover.row + direction == target_row) || (!mover.hasMoved && mover.row + direction * 2 == target_row)); // Is moving by 1 or 2 rows (2 only before its first move)
+
+    // Capturing along a diagonal they are facing
+    Attacks::Mask captures = Attacks::pawnAttacks(mover.row * BOARD_LENGTH + mover.col, mover.movingUp);
+    bool can_capture_diagonal = !target_empty && (captures & Attacks::squareMask(target_row * BOARD_LENGTH + target_col));
+
+    return can_move_straight || can_capture_diagonal;
+}
+
+/**
+ * @brief Determines whether a knight can move to the target position (an L-shape move)
+ */
+template <typename Board>
+bool MoveRules::knightCanMove(const Mover& mover, const int& target_row, const int& target_col, const Board& board) {
+    if (!isOpenTarget(mover, target_row, target_col, board)) { return false; }
+
+    return Attacks::knightAttacks(mover.row * BOARD_LENGTH + mover.col) & Attacks::squareMask(target_row * BOARD_LENGTH + target_col);
+}
+
+/**
+ * @brief Determines whether a bishop can move to the target position (a diagonal line, unobstructed before the target)
+ */
+template <typename Board>
+bool MoveRules::bishopCanMove(const Mover& mover, const int& target_row, const int& target_col, const Board& board) {
+    if (!isOpenTarget(mover, target_row, target_col, board)) { return false; }
+
+    // The target is on one of the empty-board lines, and nothing stands between
+    const int square = mover.row * BOARD_LENGTH + mover.col;
+    const int target = target_row * BOARD_LENGTH + target_col;
+    return (Attacks::bishopAttacks(square, 0) & Attacks::squareMask(target)) && board.isClear(Attacks::between(square, target));
+}
+
+/**
+ * @brief Determines whether a rook can move to the target position (a horizontal or vertical line, unobstructed before the target)
+ */
+template <typename Board>
+bool MoveRules::rookCanMove(const Mover& mover, const int& target_row, const int& target_col, const Board& board) {
+    // A friendly target is rejected here, so castling is left to the board (see Rook::canCastle)
+    if (!isOpenTarget(mover, target_row, target_col, board)) { return false; }
+
+    // The target is on one of the empty-board lines, and nothing stands between
+    const int square = mover.row * BOARD_LENGTH + mover.col;
+    const int target = target_row * BOARD_LENGTH + target_col;
+    return (Attacks::rookAttacks(square, 0) & Attacks::squareMask(target)) && board.isClear(Attacks::between(square, target));
+}
+
+/**
+ * @brief Determines whether a queen can move to the target position (a straight or diagonal line, unobstructed before the target)
+ */
+template <typename Board>
+bool MoveRules::queenCanMove(const Mover& mover, const int& target_row, const int& target_col, const Board& board) {
+    if (!isOpenTarget(mover, target_row, target_col, board)) { return false; }
+
+    // The target is on one of the empty-board lines, and nothing stands between
+    const int square = mover.row * BOARD_LENGTH + mover.col;
+    const int target = target_row * BOARD_LENGTH + target_col;
+    return (Attacks::queenAttacks(square, 0) & Attacks::squareMask(target)) && board.isClear(Attacks::between(square, target));
+}
+
+/**
+ * @brief Determines whether a king can move to the target position (any adjacent cell)
+ */
+template <typename Board>
+bool MoveRules::kingCanMove(const Mover& mover, const int& target_row, const int& target_col, const Board& board) {
+    if (!isOpenTarget(mover, target_row, target_col, board)) { return false; }
+
+    return Attacks::kingAttacks(mover.row * BOARD_LENGTH + mover.col) & Attacks::squareMask(target_row * BOARD_LENGTH + target_col);
+}
+
+/**
+ * @brief Determines whether a piece can move to the target position, dispatching on its type without a virtual call
+ *
+ * @param mover A const reference to the state of the moving piece
+ * @param target_row A const reference to the row of the target position
+ * @param target_col A const reference to the column of the target position
+ * @param board A const reference to the Board the piece moves on
+ * @return True if the piece can move to the target position. False otherwise (always false for PieceType::NONE).
+ */
+template <typename Board>
+bool MoveRules::canMove(const Mover& mover, const int& target_row, const int& target_col, const Board& board) {
+    switch (mover.type) {
+        case PieceType::PAWN:   return pawnCanMove(mover, target_row, target_col, board);
+        case PieceType::KNIGHT: return knightCanMove(mover, target_row, target_col, board);
+        case PieceType::BISHOP: return bishopCanMove(mover, target_row, target_col, board);
+        case PieceType::ROOK:   return rookCanMove(mover, target_row, target_col, board);
+        case PieceType::QUEEN:  return queenCanMove(mover, target_row, target_col, board);
+        case PieceType::KING:   return kingCanMove(mover, target_row, target_col, board);
+        default:                return false;
+    }
+}
+
+/**
+ * @brief Finds every target position a piece can move to, in one call
+ *
+ * @param mover A const reference to the state of the moving piece
+ * @param board A const reference to the Board the piece moves on
+ * @return A mask with bit (target_row * BOARD_LENGTH + target_col) set exactly when canMove(mover, target_row, target_col, board) is true
+ */
+template <typename Board>
+Attacks::Mask MoveRules::reachableSquares(const Mover& mover, const Board& board) {
+    // Not on the board
+    if (mover.row == -1 || mover.col == -1) { return 0; }
+
+    // Off-board squares of a smaller board are never targets
+    int square = mover.row * BOARD_LENGTH + mover.col;
+    Attacks::Mask open = ~board.occupancyOf(mover.color) & boardSquares(board.length());
+
+    switch (mover.type) {
+        case PieceType::PAWN: {
+            Attacks::Mask occupied = board.occupancy();
+            Attacks::Mask targets = Attacks::pawnAttacks(square, mover.movingUp) & occupied;
+
+            // Pushes only need their target to be empty (see pawnCanMove)
+            int direction = mover.movingUp ? 1 : -1;
+            for (int rows = 1; rows <= (mover.hasMoved ? 1 : 2); rows++) {
+                int row = mover.row + direction * rows;
+                if (row >= 0 && row < board.length()) { targets |= Attacks::squareMask(row * BOARD_LENGTH + mover.col) & ~occupied; }
+            }
+
+            return targets & open;
+        }
+        case PieceType::KNIGHT: return Attacks::knightAttacks(square) & open;
+        case PieceType::BISHOP: return Attacks::bishopAttacks(square, board.occupancy()) & open;
+        case PieceType::ROOK:   return Attacks::rookAttacks(square, board.occupancy()) & open;
+        case PieceType::QUEEN:  return Attacks::queenAttacks(square, board.occupancy()) & open;
+        case PieceType::KING:   return Attacks::kingAttacks(square) & open;
+        default:                return 0;
+    }
+}
+
+/**
+ * @brief Determines whether a ChessPiece can move to the target position, without a virtual call
+ * @return The same result as piece.canMove(target_row, target_col, board)
+ */
+inline bool MoveRules::canMove(const ChessPiece& piece, const int& target_row, const int& target_col, const std::vector<std::vector<ChessPiece*>>& board) {
+    return canMove(moverOf(piece), target_row, target_col, PieceGrid(board));
+}
@@ -0,0 +1,185 @@
+/**
+ * @namespace MoveRules
+ * @brief The movement rules of every chess piece, as inline functions selected by a switch on PieceType.
+ *
+ * The rules are templates over the board they read, so the same rules validate moves on a grid of
+ * ChessPiece pointers (see PieceGrid) and on a Mailbox, and the compiler can inline them into tight loops.
+ * Each piece's virtual canMove is a thin shim over its rule. Apart from pawn pushes, each rule answers with 
+ * a lookup in the Attacks tables and a mask test.
+ *
+ * A Board is any type with the members
+ *      `int length() const`, returning the number of rows & columns of the board (at most BOARD_LENGTH)
+ *      `int colorAt(const int& row, const int& col) const`, returning the ChessPiece::Color of the piece on (row, col), or EMPTY if the cell is empty
+ *      `bool isClear(const Attacks::Mask& squares) const`, returning true if none of `squares` is occupied (read by rooks, bishops and queens)
+ *      `Attacks::Mask occupancy() const`, returning the mask of every occupied square
+ *      `Attacks::Mask occupancyOf(const ChessPiece::Color& color) const`, returning the mask of the squares held by pieces of `color` (only read by reachableSquares)
+ */
+
+#pragma once
+#include <cstdlib>
+#include <vector>
+#include "ChessPiece.hpp"
+#include "Attacks.hpp"
+
+namespace MoveRules {
+    // The number of rows & columns on the chessboard
+    constexpr int BOARD_LENGTH = 8;
+
+    // The colorAt value of an empty cell
+    constexpr int EMPTY = -1;
+
+    /**
+     * @brief The state of a moving piece, as read by the rules
+     */
+    struct Mover {
+        PieceType type;
+        ChessPiece::Color color;
+        int row;            // -1 if the piece is not on the board
+        int col;            // -1 if the piece is not on the board
+        bool movingUp;
+        bool hasMoved;
+    };
+
+    /**
+     * @brief Reads a 2D vector of ChessPiece pointers as a Board
+     * @pre The grid is square, with at most BOARD_LENGTH rows & columns (the n-queens search passes n x n grids)
+     *
+     * A grid is built for every canMove query, so isClear walks only the squares it is given: the cells between a 
+     * slider and its target. Nothing reads the whole grid unless occupancy or occupancyOf is called.
+     */
+    class PieceGrid {
+        private:
+            const std::vector<std::vector<ChessPiece*>>& cells_;
+
+        public:
+            explicit PieceGrid(const std::vector<std::vector<ChessPiece*>>& cells) : cells_{cells} {}
+
+            int length() const { return static_cast<int>(cells_.size()); }
+
+            int colorAt(const int& row, const int& col) const {
+                const ChessPiece* piece = cells_[row][col];
+                return piece ? piece->getColorId() : EMPTY;
+            }
+
+            bool isClear(const Attacks::Mask& squares) const {
+                for (Attacks::Mask left = squares; left; left &= left - 1) {
+                    const int square = __builtin_ctzll(left);
+                    if (cells_[square / BOARD_LENGTH][square % BOARD_LENGTH]) { return false; }
+                }
+
+                return true;
+            }
+
+            Attacks::Mask occupancy() const {
+                Attacks::Mask occupied = 0;
+                for (int row = 0; row < static_cast<int>(cells_.size()); row++) {
+                    for (int col = 0; col < static_cast<int>(cells_[row].size()); col++) {
+                        if (cells_[row][col]) { occupied |= Attacks::squareMask(row * BOARD_LENGTH + col); }
+                    }
+                }
+
+                return occupied;
+            }
+
+            Attacks::Mask occupancyOf(const ChessPiece::Color& color) const {
+                Attacks::Mask occupied = 0;
+                for (int row = 0; row < static_cast<int>(cells_.size()); row++) {
+                    for (int col = 0; col < static_cast<int>(cells_[row].size()); col++) {
+                        if (colorAt(row, col) == color) { occupied |= Attacks::squareMask(row * BOARD_LENGTH + col); }
+                    }
+                }
+
+                return occupied;
+            }
+    };
+
+    /**
+     * @brief Gets the squares of a board smaller than the chessboard
+     * @param length A const reference to the number of rows & columns of the board, in [0, BOARD_LENGTH]
+     * @return A mask with bit (row * BOARD_LENGTH + col) set for every row & col below `length`
+     */
+    constexpr Attacks::Mask boardSquares(const int& length) {
+        return length >= BOARD_LENGTH ? ~0ull : ((1ull << (length * BOARD_LENGTH)) - 1) / 0xFF * ((1ull << length) - 1);
+    }
+
+    /**
+     * @brief Reads the state of a ChessPiece
+     * @param piece A const reference to a ChessPiece
+     * @return The Mover describing `piece`
+     */
+    inline Mover moverOf(const ChessPiece& piece);
+
+    /**
+     * @brief Checks the conditions shared by every piece: the piece is on the board, and the target is on the board and not held by a friendly piece
+     * @return True if the move passes these checks. False otherwise.
+     */
+    template <typename Board>
+    bool isOpenTarget(const Mover& mover, const int& target_row, const int& target_col, const Board& board);
+
+    /**
+     * @brief Determines whether a pawn can move to the target position: one row forward onto an empty cell
+     *      (or two, if it has not moved yet), or one row forward diagonally onto an enemy piece
+     */
+    template <typename Board>
+    bool pawnCanMove(const Mover& mover, const int& target_row, const int& target_col, const Board& board);
+
+    /**
+     * @brief Determines whether a knight can move to the target position (an L-shape move)
+     */
+    template <typename Board>
+    bool knightCanMove(const Mover& mover, const int& target_row, const int& target_col, const Board& board);
+
+    /**
+     * @brief Determines whether a bishop can move to the target position (a diagonal line, unobstructed before the target)
+     */
+    template <typename Board>
+    bool bishopCanMove(const Mover& mover, const int& target_row, const int& target_col, const Board& board);
+
+    /**
+     * @brief Determines whether a rook can move to the target position (a horizontal or vertical line, unobstructed before the target)
+     */
+    template <typename Board>
+    bool rookCanMove(const Mover& mover, const int& target_row, const int& target_col, const Board& board);
+
+    /**
+     * @brief Determines whether a queen can move to the target position (a straight or diagonal line, unobstructed before the target)
+     */
+    template <typename Board>
+    bool queenCanMove(const Mover& mover, const int& target_row, const int& target_col, const Board& board);
+
+    /**
+     * @brief Determines whether a king can move to the target position (any adjacent cell)
+     */
+    template <typename Board>
+    bool kingCanMove(const Mover& mover, const int& target_row, const int& target_col, const Board& board);
+
+    /**
+     * @brief Determines whether a piece can move to the target position, dispatching on its type without a virtual call
+     *
+     * @param mover A const reference to the state of the moving piece
+     * @param target_row A const reference to the row of the target position
+     * @param target_col A const reference to the column of the target position
+     * @param board A const reference to the Board the piece moves on
+     * @return True if the piece can move to the target position. False otherwise (always false for PieceType::NONE).
+     */
+    template <typename Board>
+    bool canMove(const Mover& mover, const int& target_row, const int& target_col, const Board& board);
+
+    /**
+     * @brief Finds every target position a piece can move to, in one call
+     *
+     * @param mover A const reference to the state of the moving piece
+     * @param board A const reference to the Board the piece moves on
+     * @return A mask with bit (target_row * BOARD_LENGTH + target_col) set exactly when canMove(mover, target_row, target_col, board) is true
+     */
+    template <typename Board>
+    Attacks::Mask reachableSquares(const Mover& mover, const Board& board);
+
+    /**
+     * @brief Determines whether a ChessPiece can move to the target position, without a virtual call
+     * @return The same result as piece.canMove(target_row, target_col, board)
+     */
+    inline bool canMove(const ChessPiece& piece, const int& target_row, const int& target_col, const std::vector<std::vector<ChessPiece*>>& board);
+};
+
+#include "MoveRules.cpp"
@@ -1,11 +1,12 @@
 #include "Pawn.hpp"
+#include "MoveRules.hpp"
 
 /**
  * @brief Default Constructor. All boolean values are default initialized to false.
  * @note Remember to default construct the base-class as well
  * @post Sets the piece_size_ member to 1. Sets the type to "PAWN"
  */
-Pawn::Pawn() : ChessPiece() { setSize(1); setType("PAWN"); }
+Pawn::Pawn() : ChessPiece() { setSize(sizeOf(PieceType::PAWN)); setType(PieceType::PAWN); }
 
 /**
 * @brief Parameterized constructor.
@@ -20,7 +21,7 @@ Pawn::Pawn() : ChessPiece() { setSize(1); setType("PAWN"); }
 *   The type member is set to "PAWN"
 */
 Pawn::Pawn(const std::string& color, const int& row, const int& col, const bool& movingUp) :
-    ChessPiece(color, row, col, movingUp, 1, "PAWN") {}
+    ChessPiece(color, row, col, movingUp, sizeOf(PieceType::PAWN), PieceType::PAWN) {}
 
 /**
  * @brief Determines whether a Pawn can perform a adouble jump or not.
@@ -42,28 +43,10 @@ bool Pawn::canPromote() const {
         (!isMovingUp() && getRow() == 0);
 }
 
-// Either two forward, or diagonal to capture piece
+/**
+ * @brief Determines whether the Pawn can move to the target position. 
+ * @note A thin shim over MoveRules::pawnCanMove, which callers that know the piece type can call without a virtual call.
+ */
 bool Pawn::canMove(const int& target_row, const int& target_col, const std::vector<std::vector<ChessPiece*>>& board) const {
-    // Not on the board 
-    if (getRow() == -1 || getColumn() == -1) { return false; } 
-
-    // Out of bounds target
-    if (target_row < 0 || target_row >= BOARD_LENGTH || target_col < 0 || target_col >= BOARD_LENGTH) { return false; };
-
-    ChessPiece* target_piece = board[target_row][target_col];
-    if (target_piece && target_piece->getColor() == getColor()) { return false; }
-
-
-    int direction = isMovingUp() ? 1 : -1;
-    bool can_move_straight = 
-        (!target_piece && getColumn() == target_col) && // Is moving straight (and there is noe obstructing piece)
-        ((getRow() + direction == target_row) || (canDoubleJump() && getRow() + direction * 2 == target_row)); // Is moving by 1 or 2 rows (depending on the canDoubleJump flag)
-
-
-    bool can_capture_diagonal =
-        (target_piece && std::abs(getColumn() - target_col) == 1) && // Moving along some diagonal
-        (getRow() + direction == target_row); // Moving along a diagonal they are facing
-
-
-    return can_move_straight || can_capture_diagonal;
-}
\ No newline at end of file
+    return MoveRules::pawnCanMove(MoveRules::moverOf(*this), target_row, target_col, MoveRules::PieceGrid(board));
+}
@@ -1,11 +1,12 @@
 #include "Rook.hpp"
+#include "MoveRules.hpp"
 
 /**
  * @brief Default Constructor. By default, Rooks have 3 available castle moves to make
  * @note Remember to default construct the base-class as well
  * @post Sets the piece_size_ member to 1. Sets the type to "PAWN"
  */
-Rook::Rook() : ChessPiece(), castle_moves_left_{3} { setSize(2); setType("ROOK"); }
+Rook::Rook() : ChessPiece(), castle_moves_left_{3} { setSize(sizeOf(PieceType::ROOK)); setType(PieceType::ROOK); }
 
 /**
 * @brief Parameterized constructor. Rememeber to use the arguments to construct the underlying ChessPiece.
@@ -14,14 +15,14 @@ Rook::Rook() : ChessPiece(), castle_moves_left_{3} { setSize(2); setType("ROOK")
 * @param : The 0-indexed row position of the Rook (as a const reference to an integer). Default value -1 if not provided, or if the value provided is outside the board's dimensions, [0, BOARD_LENGTH)
 * @param : The 0-indexed column position of the Rook (as a const reference to an integer). Default value -1 if not provided, or if the value provided is outside the board's dimensions, [0, BOARD_LENGTH)
 * @param : A flag indicating whether the Rook is moving up on the board, or not (as a const reference to a boolean). Default value false if not provided.
-* @param : An integer representing how many castle moves it can make. Default to 3 if no value provided. If a negative value is provided, 0 is used instead.
+* @param : An integer representing how many castle moves it can make. Default to 3 if no value provided. If a negative value is provided, 0 is used instead (and values above 255 are capped at 255).
 * @post : The private members are set to the values of the corresponding parameters. 
 *   If either of row or col are out-of-bounds and set to -1, the other is also set to -1 (regardless of being in-bounds or not).
 *   The piece_size_ member is set to 1
 *   The type member is set to "PAWN"
 */
 Rook::Rook(const std::string& color, const int& row, const int& col, const bool& movingUp, const int& castle_moves_capacity) :
-    ChessPiece(color, row, col, movingUp, 2, "ROOK"), castle_moves_left_{ std::max(0, castle_moves_capacity) } {}
+    ChessPiece(color, row, col, movingUp, sizeOf(PieceType::ROOK), PieceType::ROOK), castle_moves_left_{ static_cast<uint8_t>(std::clamp(castle_moves_capacity, 0, UINT8_MAX)) } {}
 
 /**
  * @brief Gets the value of the castle_moves_left_
@@ -42,7 +43,7 @@ int Rook::getCastleMovesLeft() const {
  */
 bool Rook::canCastle(const ChessPiece& target) const {
     // Ensure there are castle moves available & the pieces share color
-    if (castle_moves_left_ == 0 || getColor() != target.getColor()) { return false; }
+    if (castle_moves_left_ == 0 || getColorId() != target.getColorId()) { return false; }
 
     // Ensure both pieces are on the board
     if (getRow() < 0 || getColumn() < 0 || target.getRow() < 0 || target.getColumn() < 0) { return false; }
@@ -53,49 +54,10 @@ bool Rook::canCastle(const ChessPiece& target) const {
     return true;
 }
 
+/**
+ * @brief Determines whether the Rook can move to the target position. 
+ * @note A thin shim over MoveRules::rookCanMove, which callers that know the piece type can call without a virtual call.
+ */
 bool Rook::canMove(const int& target_row, const int& target_col, const std::vector<std::vector<ChessPiece*>>& board) const {
-    // Not on the board 
-    if (getRow() == -1 || getColumn() == -1) { return false; } 
-    // Out of bounds target
-    if (target_row < 0 || target_row >= BOARD_LENGTH || target_col < 0 || target_col >= BOARD_LENGTH) { return false; };
-    
-
-    // Account for castle in ChessBoard move()
-    ChessPiece* target_piece = board[target_row][target_col];
-    if (target_piece) {
-        if (target_piece->getColor() == getColor()) { return false; }
-        if (canCastle(*target_piece)) { return true; } // It can only castle if it is adjacent anyway
-    }
-    
-    // Get the difference between the current position and the target position
-    // -,0,+  -->  represents left, no movement, right
-    int row_difference = target_row - getRow(); 
-    // -,0,+  -->  represents down, no movement, up
-    int col_difference = target_col - getColumn(); 
-
-    // Same cell OR not a horizontal / vertical line
-    bool stays_in_same_position = (row_difference == 0) && (col_difference == 0);
-    bool moves_straight = (row_difference == 0) || (col_difference == 0);
-    if (stays_in_same_position || !moves_straight) { return false; }
-
-    // Find what direction we should step 
-    int increment_row = 0;
-    int increment_col = 0;
-    if (row_difference > 0) { increment_row = 1; }  // Moving right
-    if (row_difference < 0) { increment_row = -1; } // Moving left
-
-    if (col_difference > 0) { increment_col = 1; }  // Moving up
-    if (col_difference < 0) { increment_col = -1; } // Moving down
-    
-    // Iterate from the original space to target space and check if there is any obstructing Chess Piece
-    int temp_row = getRow();
-    int temp_col = getColumn();
-
-    while (temp_row != target_row || temp_col != target_col) {
-        temp_row += increment_row;
-        temp_col += increment_col;
-        if (board[temp_row][temp_col]) { return false; }
-    }
-
-    return true;
+    return MoveRules::rookCanMove(MoveRules::moverOf(*this), target_row, target_col, MoveRules::PieceGrid(board));
 }
@@ -8,7 +8,7 @@
 
 class Rook : public ChessPiece {
     private: 
-        int castle_moves_left_; // Default to 3
+        uint8_t castle_moves_left_; // Default to 3
 
     public:
         /**
@@ -0,0 +1,62 @@
+// Command line driver checking the queen engines against each other.
+//
+// Usage: queens [max_n] [-t threads]
+//      max_n       Solve every board from 1 x 1 to max_n x max_n (8 by default, at most ChessBoard::MAX_QUEENS_LENGTH)
+//      -t          The number of worker threads of the PARALLEL engine (0, the hardware concurrency, by default)
+//
+// Every engine must find the same solutions as BITMASK, in the same order, and count as many. PIECES only runs
+// up to BOARD_LENGTH (8), the largest board its Queen objects move on. Exits with 1 on a mismatch.
+
+#include "ChessBoard.hpp"
+#include "pieces/MoveRules.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cctype>
+
+int main(int argc, char* argv[]) {
+    int maxLength = 8;
+    int threads = 0;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-t" && i + 1 < argc) { threads = std::atoi(argv[++i]); }
+        else if (!arg.empty() && std::isdigit(static_cast<unsigned char>(arg[0]))) { maxLength = std::atoi(arg.c_str()); }
+        else {
+            std::cerr << "usage: " << argv[0] << " [max_n] [-t threads]" << std::endl;
+            return 2;
+        }
+    }
+
+    if (maxLength < 1 || maxLength > ChessBoard::MAX_QUEENS_LENGTH) {
+        std::cerr << "max_n must be in [1, " << ChessBoard::MAX_QUEENS_LENGTH << "]" << std::endl;
+        return 2;
+    }
+
+    typedef ChessBoard::QueenEngine Engine;
+    const std::vector<std::pair<Engine, std::string>> engines = {
+        {Engine::PIECES, "PIECES"}, {Engine::PARALLEL, "PARALLEL"}, {Engine::SYMMETRIC, "SYMMETRIC"}
+    };
+
+    bool passed = true;
+    for (int n = 1; n <= maxLength; n++) {
+        const std::vector<QueenPlacement> expected = ChessBoard::findAllQueenSolutions(n, Engine::BITMASK);
+        const uint64_t count = ChessBoard::countQueenPlacements(n, Engine::BITMASK);
+        bool match = count == expected.size();
+
+        for (const std::pair<Engine, std::string>& engine : engines) {
+            if (engine.first == Engine::PIECES && n > MoveRules::BOARD_LENGTH) { continue; }
+
+            const bool same = ChessBoard::findAllQueenSolutions(n, engine.first, threads) == expected
+                && ChessBoard::countQueenPlacements(n, engine.first, threads) == count;
+            if (!same) { std::cout << "n " << n << ": " << engine.second << " differs from BITMASK" << std::endl; }
+            match = match && same;
+        }
+
+        passed = passed && match;
+        std::cout << "n " << n << ": " << count << (match ? " ok" : " MISMATCH") << std::endl;
+    }
+
+    return passed ? 0 : 1;
+}